@@ -0,0 +1,175 @@
+/*
+** arena.c - Bump pointer allocator
+**
+** All memory for a table (row structs, cell vectors and cell text) is
+** carved out of a few large blocks owned by the table and released in
+** one go when the table is freed. Allocations that would not fit in
+** half a block get a block of their own.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+#define ARENA_MINBLOCK 4096
+#define ARENA_MAXBLOCK (1024*1024)
+
+#define ARENA_ALIGN    sizeof(void *)
+
+#define BLOCK_DATA(bp) ((char *) ((bp)+1))
+
+
+void
+arena_init(ARENA *ap)
+{
+    ap->head = NULL;
+    ap->bsize = ARENA_MINBLOCK;
+    ap->used = 0;
+    ap->size = 0;
+    ap->blocks = 0;
+    ap->last = NULL;
+}
+
+
+static ARENA_BLOCK *
+block_new(ARENA *ap,
+	  size_t size)
+{
+    ARENA_BLOCK *bp;
+
+
+    bp = malloc(sizeof(ARENA_BLOCK)+size);
+    if (!bp)
+	return NULL;
+
+    bp->size = size;
+    bp->used = 0;
+    ap->size += sizeof(ARENA_BLOCK)+size;
+    ap->blocks++;
+    return bp;
+}
+
+
+/*
+** Allocate 'len' bytes aligned to 'align' (a power of two).
+*/
+static void *
+arena_get(ARENA *ap,
+	  size_t len,
+	  size_t align)
+{
+    ARENA_BLOCK *bp = ap->head;
+    size_t off;
+    void *p;
+
+
+    if (bp)
+    {
+	off = (bp->used + align-1) & ~(align-1);
+	if (off+len <= bp->size)
+	{
+	    p = BLOCK_DATA(bp)+off;
+	    bp->used = off+len;
+	    ap->used += len;
+	    ap->last = p;
+	    return p;
+	}
+    }
+
+    if (len > ap->bsize/2)
+    {
+	/* Too big - give it a block of its own behind the current one */
+	bp = block_new(ap, len);
+	if (!bp)
+	    return NULL;
+
+	bp->used = len;
+	if (ap->head)
+	{
+	    bp->next = ap->head->next;
+	    ap->head->next = bp;
+	}
+	else
+	{
+	    bp->next = NULL;
+	    ap->head = bp;
+	}
+
+	ap->used += len;
+	ap->last = NULL;
+	return BLOCK_DATA(bp);
+    }
+
+    bp = block_new(ap, ap->bsize);
+    if (!bp)
+	return NULL;
+
+    bp->next = ap->head;
+    ap->head = bp;
+    if (ap->bsize < ARENA_MAXBLOCK)
+	ap->bsize *= 2;
+
+    bp->used = len;
+    ap->used += len;
+    ap->last = BLOCK_DATA(bp);
+    return ap->last;
+}
+
+
+void *
+arena_alloc(ARENA *ap,
+	    size_t len)
+{
+    return arena_get(ap, len, ARENA_ALIGN);
+}
+
+
+/*
+** Grow an allocation of 'olen' bytes to 'nlen' bytes. The last
+** allocation is extended in place if there is room, anything else is
+** copied (the old space is not reused until the arena is freed).
+*/
+void *
+arena_grow(ARENA *ap,
+	   void *p,
+	   size_t olen,
+	   size_t nlen)
+{
+    ARENA_BLOCK *bp = ap->head;
+    void *np;
+
+
+    if (p && p == ap->last && (char *) p+nlen <= BLOCK_DATA(bp)+bp->size)
+    {
+	bp->used += nlen-olen;
+	ap->used += nlen-olen;
+	return p;
+    }
+
+    np = arena_alloc(ap, nlen);
+    if (np && p)
+	memcpy(np, p, olen);
+
+    return np;
+}
+
+
+/*
+** Release all memory of the arena. It may be used again afterwards.
+*/
+void
+arena_free(ARENA *ap)
+{
+    ARENA_BLOCK *bp, *next;
+
+
+    for (bp = ap->head; bp; bp = next)
+    {
+	next = bp->next;
+	free(bp);
+    }
+
+    arena_init(ap);
+}
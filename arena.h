@@ -0,0 +1,38 @@
+/* arena.h */
+
+#ifndef PHTX_ARENA_H
+#define PHTX_ARENA_H
+
+typedef struct arena_block {
+    struct arena_block *next;
+    size_t size;  /* Usable bytes in data[] */
+    size_t used;
+} ARENA_BLOCK;
+
+typedef struct arena {
+    ARENA_BLOCK *head;  /* Block currently allocated from, then older ones */
+    size_t bsize;       /* Size of the next regular block */
+    size_t used;        /* Bytes handed out */
+    size_t size;        /* Bytes malloc()ed for blocks */
+    int blocks;         /* ... in this many blocks */
+    void *last;         /* Last allocation from 'head' */
+} ARENA;
+
+
+extern void
+arena_init(ARENA *ap);
+
+extern void *
+arena_alloc(ARENA *ap,
+	    size_t len);
+
+extern void *
+arena_grow(ARENA *ap,
+	   void *p,
+	   size_t olen,
+	   size_t nlen);
+
+extern void
+arena_free(ARENA *ap);
+
+#endif
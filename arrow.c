@@ -0,0 +1,754 @@
+/*
+** arrow.c - Apache Arrow IPC stream output
+**
+** Writes tables as Arrow IPC streams (a Schema message, RecordBatch
+** messages and an end-of-stream marker) without needing the Arrow
+** libraries. Only what phtx needs is supported: non-null int32
+** columns and nullable utf8 columns, in little endian byte order.
+**
+** The message headers are FlatBuffers, built by a minimal builder
+** that (like the real one) writes back to front, so objects are
+** created before the objects referring to them and all offsets point
+** forward in the finished buffer.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#include "arrow.h"
+
+#define FBB_MAXFIELDS 8
+
+/* Message header types and field types of the Arrow schema */
+#define MSG_SCHEMA      1
+#define MSG_RECORDBATCH 3
+#define TYPE_INT        2
+#define TYPE_UTF8       5
+#define METADATA_V5     4
+
+#define PAD8(n) (((n)+7) & ~(size_t) 7)
+
+
+typedef struct fbb {
+    char *buf;      /* Data is at the end: buf+size-len ... buf+size */
+    size_t len;
+    size_t size;
+    int err;
+
+    size_t tstart;  /* Table being built */
+    int fn;
+    size_t fref[FBB_MAXFIELDS];
+} FBB;
+
+
+static void
+put32(char *p,
+      unsigned long v)
+{
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+
+static void
+put64(char *p,
+      unsigned long long v)
+{
+    put32(p, (unsigned long) (v & 0xFFFFFFFFUL));
+    put32(p+4, (unsigned long) (v >> 32));
+}
+
+
+static char *
+fbb_room(FBB *b,
+	 size_t n)
+{
+    size_t ns;
+    char *nbuf;
+
+
+    if (b->err)
+	return NULL;
+
+    if (b->len+n > b->size)
+    {
+	ns = b->size ? b->size*2 : 1024;
+	while (ns < b->len+n)
+	    ns *= 2;
+
+	nbuf = malloc(ns);
+	if (!nbuf)
+	{
+	    b->err = 1;
+	    return NULL;
+	}
+
+	if (b->len)
+	    memcpy(nbuf+ns-b->len, b->buf+b->size-b->len, b->len);
+	free(b->buf);
+	b->buf = nbuf;
+	b->size = ns;
+    }
+
+    b->len += n;
+    return b->buf+b->size-b->len;
+}
+
+
+static void
+fbb_push(FBB *b,
+	 const void *p,
+	 size_t n)
+{
+    char *cp = fbb_room(b, n);
+
+    if (cp)
+	memcpy(cp, p, n);
+}
+
+
+static void
+fbb_pad(FBB *b,
+	size_t n)
+{
+    char *cp = fbb_room(b, n);
+
+    if (cp)
+	memset(cp, 0, n);
+}
+
+
+/* Pad so that 'extra' more bytes end 'align' aligned */
+static void
+fbb_prep(FBB *b,
+	 size_t align,
+	 size_t extra)
+{
+    fbb_pad(b, (~(b->len+extra)+1) & (align-1));
+}
+
+
+static void
+fbb_u8(FBB *b,
+       int v)
+{
+    char c = v;
+
+    fbb_push(b, &c, 1);
+}
+
+
+static void
+fbb_u16(FBB *b,
+	int v)
+{
+    char tmp[2];
+
+    tmp[0] = v;
+    tmp[1] = v >> 8;
+    fbb_push(b, tmp, 2);
+}
+
+
+static void
+fbb_u32(FBB *b,
+	unsigned long v)
+{
+    char tmp[4];
+
+    put32(tmp, v);
+    fbb_push(b, tmp, 4);
+}
+
+
+static void
+fbb_u64(FBB *b,
+	unsigned long long v)
+{
+    char tmp[8];
+
+    put64(tmp, v);
+    fbb_push(b, tmp, 8);
+}
+
+
+/* Offset to an object created before */
+static void
+fbb_uoffset(FBB *b,
+	    size_t ref)
+{
+    fbb_prep(b, 4, 0);
+    fbb_u32(b, b->len+4-ref);
+}
+
+
+static size_t
+fbb_string(FBB *b,
+	   const char *str,
+	   size_t len)
+{
+    fbb_prep(b, 4, len+1);
+    fbb_pad(b, 1);
+    fbb_push(b, str, len);
+    fbb_u32(b, len);
+    return b->len;
+}
+
+
+/* Vector of offsets to objects */
+static size_t
+fbb_offsets(FBB *b,
+	    const size_t *refs,
+	    int n)
+{
+    int i;
+
+
+    fbb_prep(b, 4, 4*n);
+    for (i = n-1; i >= 0; i--)
+	fbb_uoffset(b, refs[i]);
+    fbb_u32(b, n);
+    return b->len;
+}
+
+
+/* Vector of structs of two longs (FieldNode and Buffer) */
+static size_t
+fbb_pairs(FBB *b,
+	  const long long *v,
+	  int n)
+{
+    int i;
+
+
+    fbb_prep(b, 4, 16*n);
+    fbb_prep(b, 8, 16*n);
+    for (i = n-1; i >= 0; i--)
+    {
+	fbb_u64(b, v[2*i+1]);
+	fbb_u64(b, v[2*i]);
+    }
+    fbb_u32(b, n);
+    return b->len;
+}
+
+
+static void
+fbb_start(FBB *b)
+{
+    b->tstart = b->len;
+    b->fn = 0;
+    memset(b->fref, 0, sizeof(b->fref));
+}
+
+
+static void
+fbb_slot(FBB *b,
+	 int id)
+{
+    b->fref[id] = b->len;
+    if (id >= b->fn)
+	b->fn = id+1;
+}
+
+
+static void
+fbb_field_u8(FBB *b,
+	     int id,
+	     int v)
+{
+    fbb_u8(b, v);
+    fbb_slot(b, id);
+}
+
+
+static void
+fbb_field_u16(FBB *b,
+	      int id,
+	      int v)
+{
+    fbb_prep(b, 2, 0);
+    fbb_u16(b, v);
+    fbb_slot(b, id);
+}
+
+
+static void
+fbb_field_u32(FBB *b,
+	      int id,
+	      unsigned long v)
+{
+    fbb_prep(b, 4, 0);
+    fbb_u32(b, v);
+    fbb_slot(b, id);
+}
+
+
+static void
+fbb_field_u64(FBB *b,
+	      int id,
+	      unsigned long long v)
+{
+    fbb_prep(b, 8, 0);
+    fbb_u64(b, v);
+    fbb_slot(b, id);
+}
+
+
+static void
+fbb_field_ref(FBB *b,
+	      int id,
+	      size_t ref)
+{
+    fbb_uoffset(b, ref);
+    fbb_slot(b, id);
+}
+
+
+/* Finish a table: add its vtable in front and point the table at it */
+static size_t
+fbb_end(FBB *b)
+{
+    size_t tref;
+    int i;
+
+
+    fbb_prep(b, 4, 0);
+    fbb_u32(b, 0);
+    tref = b->len;
+
+    for (i = b->fn-1; i >= 0; i--)
+	fbb_u16(b, b->fref[i] ? tref-b->fref[i] : 0);
+    fbb_u16(b, tref-b->tstart);
+    fbb_u16(b, 4+2*b->fn);
+
+    if (!b->err)
+	put32(b->buf+b->size-tref, b->len-tref);
+    return tref;
+}
+
+
+/*
+** Finish a Message with the given header and write it, prefixed with
+** the continuation marker and its (8 byte aligned) length.
+*/
+static int
+fbb_message(FBB *b,
+	    OUTBUF *ob,
+	    int type,
+	    size_t header,
+	    size_t bodylen)
+{
+    char tmp[8];
+    size_t msg;
+    int rc = -1;
+
+
+    fbb_start(b);
+    fbb_field_u64(b, 3, bodylen);
+    fbb_field_ref(b, 2, header);
+    fbb_field_u16(b, 0, METADATA_V5);
+    fbb_field_u8(b, 1, type);
+    msg = fbb_end(b);
+
+    /* Root offset */
+    fbb_prep(b, 8, 4);
+    fbb_uoffset(b, msg);
+
+    if (b->err)
+	errno = ENOMEM;
+    else
+    {
+	put32(tmp, 0xFFFFFFFFUL);
+	put32(tmp+4, b->len);
+	if (ob_write(ob, tmp, 8) == 0 &&
+	    ob_write(ob, b->buf+b->size-b->len, b->len) == 0)
+	    rc = 0;
+    }
+
+    free(b->buf);
+    return rc;
+}
+
+
+static char *
+abuf_room(ARROW_BUF *bp,
+	  size_t n)
+{
+    size_t ns;
+    char *nbuf;
+
+
+    if (bp->len+n > bp->size)
+    {
+	ns = bp->size ? bp->size*2 : 256;
+	while (ns < bp->len+n)
+	    ns *= 2;
+
+	nbuf = realloc(bp->buf, ns);
+	if (!nbuf)
+	    return NULL;
+
+	bp->buf = nbuf;
+	bp->size = ns;
+    }
+
+    return bp->buf+bp->len;
+}
+
+
+static int
+abuf_put32(ARROW_BUF *bp,
+	   unsigned long v)
+{
+    char *cp = abuf_room(bp, 4);
+
+    if (!cp)
+	return -1;
+
+    put32(cp, v);
+    bp->len += 4;
+    return 0;
+}
+
+
+/* Empty a column for the next batch */
+static int
+col_reset(ARROW_COL *cp)
+{
+    cp->n = 0;
+    cp->nulls = 0;
+    cp->valid.len = 0;
+    cp->data.len = 0;
+    cp->offsets.len = 0;
+
+    return abuf_put32(&cp->offsets, 0);
+}
+
+
+/* Set the validity bit of the next row of a column */
+static int
+col_valid(ARROW_COL *cp,
+	  int valid)
+{
+    char *bp;
+
+
+    if (cp->n % 8 == 0)
+    {
+	bp = abuf_room(&cp->valid, 1);
+	if (!bp)
+	    return -1;
+	*bp = 0;
+	cp->valid.len++;
+    }
+
+    if (valid)
+	cp->valid.buf[cp->n/8] |= 1 << (cp->n%8);
+    else
+	cp->nulls++;
+
+    cp->n++;
+    return 0;
+}
+
+
+/*
+** Set up a batch of 'nc' columns. The caller fills in the name and
+** type of each column.
+*/
+int
+arrow_init(ARROW_BATCH *ab,
+	   int nc)
+{
+    int i;
+
+
+    ab->nc = nc;
+    ab->cv = calloc(nc > 0 ? nc : 1, sizeof(ARROW_COL));
+    if (!ab->cv)
+	return -1;
+
+    for (i = 0; i < nc; i++)
+	if (col_reset(&ab->cv[i]) < 0)
+	    return -1;
+
+    return 0;
+}
+
+
+void
+arrow_free(ARROW_BATCH *ab)
+{
+    int i;
+
+
+    for (i = 0; i < ab->nc; i++)
+    {
+	free(ab->cv[i].valid.buf);
+	free(ab->cv[i].offsets.buf);
+	free(ab->cv[i].data.buf);
+    }
+
+    free(ab->cv);
+    ab->cv = NULL;
+    ab->nc = 0;
+}
+
+
+/*
+** Write the Schema message that starts a stream. An optional key/value
+** pair is stored as schema metadata.
+*/
+int
+arrow_schema(ARROW_BATCH *ab,
+	     OUTBUF *ob,
+	     const char *key,
+	     const char *val,
+	     size_t vlen)
+{
+    FBB b;
+    size_t *fields, name, type, children, fv, kv, md = 0, schema;
+    int i, rc;
+
+
+    memset(&b, 0, sizeof(b));
+    fields = malloc(sizeof(size_t)*(ab->nc ? ab->nc : 1));
+    if (!fields)
+	return -1;
+
+    for (i = 0; i < ab->nc; i++)
+    {
+	ARROW_COL *cp = &ab->cv[i];
+
+	name = fbb_string(&b, cp->name, strlen(cp->name));
+	children = fbb_offsets(&b, NULL, 0);
+
+	fbb_start(&b);
+	if (cp->type == ARROW_INT32)
+	{
+	    fbb_field_u32(&b, 0, 32); /* bitWidth */
+	    fbb_field_u8(&b, 1, 1);   /* is_signed */
+	}
+	type = fbb_end(&b);
+
+	fbb_start(&b);
+	fbb_field_ref(&b, 0, name);
+	fbb_field_ref(&b, 3, type);
+	fbb_field_ref(&b, 5, children);
+	fbb_field_u8(&b, 1, cp->type == ARROW_UTF8); /* nullable */
+	fbb_field_u8(&b, 2, cp->type == ARROW_INT32 ? TYPE_INT : TYPE_UTF8);
+	fields[i] = fbb_end(&b);
+    }
+    fv = fbb_offsets(&b, fields, ab->nc);
+    free(fields);
+
+    if (key)
+    {
+	size_t k, v;
+
+	k = fbb_string(&b, key, strlen(key));
+	v = fbb_string(&b, val, vlen);
+	fbb_start(&b);
+	fbb_field_ref(&b, 0, k);
+	fbb_field_ref(&b, 1, v);
+	kv = fbb_end(&b);
+	md = fbb_offsets(&b, &kv, 1);
+    }
+
+    fbb_start(&b);
+    fbb_field_ref(&b, 1, fv);
+    if (md)
+	fbb_field_ref(&b, 2, md);
+    schema = fbb_end(&b);
+
+    rc = fbb_message(&b, ob, MSG_SCHEMA, schema, 0);
+    return rc;
+}
+
+
+int
+arrow_add_int(ARROW_BATCH *ab,
+	      int col,
+	      int v)
+{
+    ARROW_COL *cp = &ab->cv[col];
+
+
+    if (abuf_put32(&cp->data, (unsigned long) v) < 0)
+	return -1;
+
+    return col_valid(cp, 1);
+}
+
+
+/*
+** Get room for a string of up to 'len' bytes in a column. The string
+** is added by arrow_str_commit() with the actual length.
+*/
+char *
+arrow_str_reserve(ARROW_BATCH *ab,
+		  int col,
+		  size_t len)
+{
+    return abuf_room(&ab->cv[col].data, len);
+}
+
+
+int
+arrow_str_commit(ARROW_BATCH *ab,
+		 int col,
+		 size_t len)
+{
+    ARROW_COL *cp = &ab->cv[col];
+
+
+    cp->data.len += len;
+    if (abuf_put32(&cp->offsets, cp->data.len) < 0)
+	return -1;
+
+    return col_valid(cp, 1);
+}
+
+
+int
+arrow_add_null(ARROW_BATCH *ab,
+	       int col)
+{
+    ARROW_COL *cp = &ab->cv[col];
+
+
+    if (cp->type != ARROW_UTF8)
+	return -1;
+
+    if (abuf_put32(&cp->offsets, cp->data.len) < 0)
+	return -1;
+
+    return col_valid(cp, 0);
+}
+
+
+static int
+write_padded(OUTBUF *ob,
+	     const char *buf,
+	     size_t len)
+{
+    static const char zero[8];
+
+
+    if (len > 0 && ob_write(ob, buf, len) < 0)
+	return -1;
+
+    return ob_write(ob, zero, PAD8(len)-len);
+}
+
+
+/*
+** Write the rows added so far as a RecordBatch message and empty the
+** batch. If 'posp' is not NULL the output position of the values of
+** the first column is stored there.
+*/
+int
+arrow_batch(ARROW_BATCH *ab,
+	    OUTBUF *ob,
+	    size_t *posp)
+{
+    FBB b;
+    long long *nodes, *bufs;
+    size_t off, len, nv, bv, rb, start;
+    int i, nb, rows;
+    ARROW_COL *cp;
+
+
+    rows = ab->nc ? ab->cv[0].n : 0;
+
+    nodes = malloc(sizeof(long long)*2*(ab->nc+1));
+    bufs = malloc(sizeof(long long)*2*(3*ab->nc+1));
+    if (!nodes || !bufs)
+    {
+	free(nodes);
+	free(bufs);
+	return -1;
+    }
+
+    off = 0;
+    nb = 0;
+    for (i = 0; i < ab->nc; i++)
+    {
+	cp = &ab->cv[i];
+	nodes[2*i] = cp->n;
+	nodes[2*i+1] = cp->nulls;
+
+	/* Validity (left out if there are no nulls) */
+	len = cp->nulls ? cp->valid.len : 0;
+	bufs[2*nb] = off;
+	bufs[2*nb+1] = len;
+	off += PAD8(len);
+	++nb;
+
+	if (cp->type == ARROW_UTF8)
+	{
+	    bufs[2*nb] = off;
+	    bufs[2*nb+1] = cp->offsets.len;
+	    off += PAD8(cp->offsets.len);
+	    ++nb;
+	}
+
+	bufs[2*nb] = off;
+	bufs[2*nb+1] = cp->data.len;
+	off += PAD8(cp->data.len);
+	++nb;
+    }
+
+    memset(&b, 0, sizeof(b));
+    nv = fbb_pairs(&b, nodes, ab->nc);
+    bv = fbb_pairs(&b, bufs, nb);
+    free(nodes);
+    free(bufs);
+
+    fbb_start(&b);
+    fbb_field_u64(&b, 0, rows);
+    fbb_field_ref(&b, 1, nv);
+    fbb_field_ref(&b, 2, bv);
+    rb = fbb_end(&b);
+
+    if (fbb_message(&b, ob, MSG_RECORDBATCH, rb, off) < 0)
+	return -1;
+
+    for (i = 0; i < ab->nc; i++)
+    {
+	cp = &ab->cv[i];
+
+	if (cp->nulls && write_padded(ob, cp->valid.buf, cp->valid.len) < 0)
+	    return -1;
+
+	if (cp->type == ARROW_UTF8 &&
+	    write_padded(ob, cp->offsets.buf, cp->offsets.len) < 0)
+	    return -1;
+
+	start = ob_pos(ob);
+	if (write_padded(ob, cp->data.buf, cp->data.len) < 0)
+	    return -1;
+	if (posp && i == 0)
+	    *posp = start;
+
+	if (col_reset(cp) < 0)
+	    return -1;
+    }
+
+    return 0;
+}
+
+
+/* End of stream marker */
+int
+arrow_eos(OUTBUF *ob)
+{
+    static const char eos[8] = { '\377', '\377', '\377', '\377', 0, 0, 0, 0 };
+
+    return ob_write(ob, eos, 8);
+}
@@ -0,0 +1,76 @@
+/* arrow.h */
+
+#ifndef PHTX_ARROW_H
+#define PHTX_ARROW_H
+
+#include "outbuf.h"
+
+#define ARROW_INT32 1
+#define ARROW_UTF8  2
+
+/* Growable byte buffer */
+typedef struct arrow_buf {
+    char *buf;
+    size_t len;
+    size_t size;
+} ARROW_BUF;
+
+typedef struct arrow_col {
+    const char *name;
+    int type;           /* ARROW_INT32 (never null) or ARROW_UTF8 */
+
+    int n;              /* Rows in the current batch */
+    int nulls;          /* ... of which are null */
+    ARROW_BUF valid;    /* Validity bitmap */
+    ARROW_BUF offsets;  /* String offsets (UTF8) */
+    ARROW_BUF data;     /* Values or string data */
+} ARROW_COL;
+
+typedef struct arrow_batch {
+    int nc;
+    ARROW_COL *cv;
+} ARROW_BATCH;
+
+
+extern int
+arrow_init(ARROW_BATCH *ab,
+	   int nc);
+
+extern void
+arrow_free(ARROW_BATCH *ab);
+
+extern int
+arrow_schema(ARROW_BATCH *ab,
+	     OUTBUF *ob,
+	     const char *key,
+	     const char *val,
+	     size_t vlen);
+
+extern int
+arrow_add_int(ARROW_BATCH *ab,
+	      int col,
+	      int v);
+
+extern char *
+arrow_str_reserve(ARROW_BATCH *ab,
+		  int col,
+		  size_t len);
+
+extern int
+arrow_str_commit(ARROW_BATCH *ab,
+		 int col,
+		 size_t len);
+
+extern int
+arrow_add_null(ARROW_BATCH *ab,
+	       int col);
+
+extern int
+arrow_batch(ARROW_BATCH *ab,
+	    OUTBUF *ob,
+	    size_t *posp);
+
+extern int
+arrow_eos(OUTBUF *ob);
+
+#endif
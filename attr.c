@@ -0,0 +1,144 @@
+/*
+** attr.c - Tag attribute tokenizer
+**
+** Splits the text of a tag into (name, value) spans in a single pass,
+** following the HTML rules: names are separated by white space or '/',
+** values may be double quoted, single quoted or unquoted, and the case
+** of names does not matter. Nothing is copied and the tag text is not
+** modified.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+
+#include "attr.h"
+
+/* White space in tags (HTML, so not the vertical tab) */
+#define is_ws(c) ((c) == ' ' || (c) == '\t' || (c) == '\n' || (c) == '\r' || (c) == '\f')
+
+
+const char *
+attr_start(const char *buf,
+	   const char *end)
+{
+    const char *cp = buf+1;
+
+
+    while (cp < end && !is_ws(*cp) && *cp != '/')
+	++cp;
+
+    return cp;
+}
+
+
+const char *
+attr_next(const char *cp,
+	  const char *end,
+	  ATTR *ap)
+{
+    char q;
+
+
+    while (cp < end && (is_ws(*cp) || *cp == '/'))
+	++cp;
+    if (cp >= end)
+	return NULL;
+
+    /* A leading '=' is part of the name */
+    ap->name = cp++;
+    while (cp < end && !is_ws(*cp) && *cp != '/' && *cp != '=')
+	++cp;
+    ap->nlen = cp-ap->name;
+
+    ap->val = NULL;
+    ap->vlen = 0;
+
+    while (cp < end && is_ws(*cp))
+	++cp;
+    if (cp >= end || *cp != '=')
+	return cp;
+
+    ++cp;
+    while (cp < end && is_ws(*cp))
+	++cp;
+
+    if (cp < end && (*cp == '"' || *cp == '\''))
+    {
+	q = *cp++;
+	ap->val = cp;
+	while (cp < end && *cp != q)
+	    ++cp;
+	ap->vlen = cp-ap->val;
+	if (cp < end)
+	    ++cp;
+    }
+    else
+    {
+	ap->val = cp;
+	while (cp < end && !is_ws(*cp))
+	    ++cp;
+	ap->vlen = cp-ap->val;
+    }
+
+    return cp;
+}
+
+
+int
+attr_is(const ATTR *ap,
+	const char *name)
+{
+    size_t i;
+
+
+    for (i = 0; i < ap->nlen; i++)
+	if (!name[i] || (ap->name[i] | 0x20) != name[i])
+	    return 0;
+
+    return name[i] == '\0';
+}
+
+
+int
+attr_int(const ATTR *ap,
+	 int def)
+{
+    const char *cp, *end;
+    int v;
+
+
+    if (!ap->val)
+	return def;
+
+    cp = ap->val;
+    end = cp+ap->vlen;
+    while (cp < end && is_ws(*cp))
+	++cp;
+    if (cp < end && *cp == '+')
+	++cp;
+    if (cp >= end || *cp < '0' || *cp > '9')
+	return def;
+
+    for (v = 0; cp < end && *cp >= '0' && *cp <= '9'; cp++)
+	v = (v > (INT_MAX-9)/10 ? INT_MAX : v*10 + (*cp-'0'));
+
+    return v;
+}
+
+
+int
+attr_find(const char *buf,
+	  const char *end,
+	  const char *name,
+	  ATTR *ap)
+{
+    const char *cp;
+
+
+    for (cp = attr_start(buf, end); (cp = attr_next(cp, end, ap)) != NULL; )
+	if (attr_is(ap, name))
+	    return 1;
+
+    return 0;
+}
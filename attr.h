@@ -0,0 +1,55 @@
+/* attr.h */
+
+#ifndef PHTX_ATTR_H
+#define PHTX_ATTR_H
+
+/* An attribute of a tag. Both spans point into the tag text itself. */
+typedef struct attr {
+    const char *name;
+    size_t nlen;
+    const char *val;   /* NULL if the attribute has no value */
+    size_t vlen;
+} ATTR;
+
+
+/*
+** Start of the attributes of the tag at 'buf' (pointing at the '<'),
+** that is the end of the tag name. 'end' is the closing '>'.
+*/
+extern const char *
+attr_start(const char *buf,
+	   const char *end);
+
+/*
+** Get the attribute at 'cp' into *ap. Returns the position after it
+** (to pass to the next call), or NULL if there are no more before 'end'.
+*/
+extern const char *
+attr_next(const char *cp,
+	  const char *end,
+	  ATTR *ap);
+
+/* Is the name of the attribute 'name' (lower case)? */
+extern int
+attr_is(const ATTR *ap,
+	const char *name);
+
+/*
+** The value of the attribute as a non-negative integer (leading digits
+** after optional white space and '+'), or 'def' if it is not one.
+*/
+extern int
+attr_int(const ATTR *ap,
+	 int def);
+
+/*
+** Find the first attribute called 'name' of the tag at 'buf'.
+** Returns 1 if it was found (and stored in *ap), else 0.
+*/
+extern int
+attr_find(const char *buf,
+	  const char *end,
+	  const char *name,
+	  ATTR *ap);
+
+#endif
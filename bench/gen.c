@@ -0,0 +1,389 @@
+/*
+** gen.c - Synthetic HTML input for the phtx benchmarks
+**
+** Writes about 'size' MB of HTML of one of a few kinds, each stressing
+** a different part of the parser. The output is deterministic for a
+** given kind, size and seed. The first line is a comment with the
+** number of cells written, which the runner uses for cells/s.
+**
+** Usage: gen [-s seed] -o file kind size-MB
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define HEADER_LEN 64  /* Space reserved for the header comment */
+
+typedef struct gen {
+    FILE *fp;
+    long long size;    /* Bytes to write (roughly) */
+    long long cells;   /* Cells written so far */
+    unsigned long rnd;
+} GEN;
+
+
+static unsigned int
+rnd(GEN *gp,
+    unsigned int n)
+{
+    /* 64 bit LCG, the high bits are good enough for this */
+    gp->rnd = gp->rnd*6364136223846793005UL + 1442695040888963407UL;
+    return (unsigned int) (gp->rnd >> 33) % n;
+}
+
+
+static int
+more(GEN *gp)
+{
+    return ftell(gp->fp) < gp->size;
+}
+
+
+static void
+word(GEN *gp)
+{
+    static const char *words[] = {
+	"alpha", "beta", "gamma", "delta", "Stockholm", "Link\xc3\xb6ping",
+	"12345", "3.1415", "2015-05-13", "N/A", "foo bar", "x"
+    };
+
+    fputs(words[rnd(gp, sizeof(words)/sizeof(words[0]))], gp->fp);
+}
+
+
+static void
+cell(GEN *gp,
+     const char *attrs)
+{
+    fprintf(gp->fp, "<td%s>", attrs ? attrs : "");
+    word(gp);
+    fputs("</td>", gp->fp);
+    ++gp->cells;
+}
+
+
+/* Wide tables, 200 columns */
+static void
+gen_wide(GEN *gp)
+{
+    int r, c;
+
+
+    while (more(gp))
+    {
+	fputs("<table>\n", gp->fp);
+	for (r = 0; r < 1000 && more(gp); r++)
+	{
+	    fputs("<tr>", gp->fp);
+	    for (c = 0; c < 200; c++)
+		cell(gp, NULL);
+	    fputs("</tr>\n", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+/* Tables nested up to 32 levels deep */
+static void
+gen_deep(GEN *gp)
+{
+    int d, depth;
+
+
+    while (more(gp))
+    {
+	depth = 1+rnd(gp, 32);
+	for (d = 0; d < depth; d++)
+	{
+	    fputs("<table><tr>", gp->fp);
+	    cell(gp, NULL);
+	    fputs("<td>", gp->fp);
+	    ++gp->cells;
+	}
+	for (d = 0; d < depth; d++)
+	{
+	    fputs("</td>", gp->fp);
+	    cell(gp, NULL);
+	    fputs("</tr></table>\n", gp->fp);
+	}
+    }
+}
+
+
+/* Cells full of named and numeric entities */
+static void
+gen_entity(GEN *gp)
+{
+    static const char *ents[] = {
+	"&amp;", "&lt;", "&gt;", "&nbsp;", "&auml;", "&eacute;", "&#228;",
+	"&#x20AC;", "&copy;", "&hellip;", "&quot;", "&NotSubsetEqual;"
+    };
+    int r, c, i;
+
+
+    while (more(gp))
+    {
+	fputs("<table>\n", gp->fp);
+	for (r = 0; r < 1000 && more(gp); r++)
+	{
+	    fputs("<tr>", gp->fp);
+	    for (c = 0; c < 10; c++)
+	    {
+		fputs("<td>", gp->fp);
+		for (i = 0; i < 8; i++)
+		{
+		    fputs(ents[rnd(gp, sizeof(ents)/sizeof(ents[0]))], gp->fp);
+		    word(gp);
+		}
+		fputs("</td>", gp->fp);
+		++gp->cells;
+	    }
+	    fputs("</tr>\n", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+/* Big row and column spans */
+static void
+gen_span(GEN *gp)
+{
+    char attrs[64];
+    int r, c;
+
+
+    while (more(gp))
+    {
+	fputs("<table>\n", gp->fp);
+	for (r = 0; r < 500 && more(gp); r++)
+	{
+	    fputs("<tr>", gp->fp);
+	    for (c = 0; c < 20; c++)
+	    {
+		switch (rnd(gp, 4))
+		{
+		  case 0:
+		    sprintf(attrs, " rowspan=%u", 2+rnd(gp, 30));
+		    break;
+		  case 1:
+		    sprintf(attrs, " colspan=\"%u\"", 2+rnd(gp, 30));
+		    break;
+		  case 2:
+		    sprintf(attrs, " rowspan=%u colspan=%u", 2+rnd(gp, 8), 2+rnd(gp, 8));
+		    break;
+		  default:
+		    attrs[0] = '\0';
+		}
+		cell(gp, attrs);
+	    }
+	    fputs("</tr>\n", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+/* Lots of small tables in running text */
+static void
+gen_small(GEN *gp)
+{
+    int r, c;
+
+
+    while (more(gp))
+    {
+	fputs("<p>Some text between the tables.</p>\n<table class=\"small\">", gp->fp);
+	for (r = 0; r < 3; r++)
+	{
+	    fputs("<tr>", gp->fp);
+	    for (c = 0; c < 3; c++)
+		cell(gp, NULL);
+	    fputs("</tr>", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+/* Long comments between and inside the cells */
+static void
+gen_comment(GEN *gp)
+{
+    int r, c, i;
+
+
+    while (more(gp))
+    {
+	fputs("<table>\n", gp->fp);
+	for (r = 0; r < 1000 && more(gp); r++)
+	{
+	    fputs("<!-- ", gp->fp);
+	    for (i = 0; i < 100; i++)
+		fputs("<td>not a cell</td> -- ", gp->fp);
+	    fputs("-->\n<tr>", gp->fp);
+	    for (c = 0; c < 10; c++)
+	    {
+		fputs("<td><!-- a comment <b>with</b> tags -->", gp->fp);
+		word(gp);
+		fputs("</td>", gp->fp);
+		++gp->cells;
+	    }
+	    fputs("</tr>\n", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+/* Big inline scripts and styles between and inside the tables */
+static void
+gen_script(GEN *gp)
+{
+    int r, c, i;
+
+
+    while (more(gp))
+    {
+	fputs("<script type=\"text/javascript\">\n", gp->fp);
+	for (i = 0; i < 1000; i++)
+	    fprintf(gp->fp, "if (a[%d] < b && c > d) { s += \"<div class='x'>\" + v + \"</div>\"; }\n", i);
+	fputs("</script>\n<style>td > p { color: red }</style>\n<table>\n", gp->fp);
+	for (r = 0; r < 100 && more(gp); r++)
+	{
+	    fputs("<tr>", gp->fp);
+	    for (c = 0; c < 5; c++)
+	    {
+		fputs("<td>", gp->fp);
+		word(gp);
+		if (c == 0)
+		    fputs("<script>document.write(\"<b>\" + n + \"</b>\");</script>", gp->fp);
+		fputs("</td>", gp->fp);
+		++gp->cells;
+	    }
+	    fputs("</tr>\n", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+/* Booking pages for the 'tidbokonline' IMG magic (-I tidbokonline) */
+static void
+gen_img(GEN *gp)
+{
+    static const char *imgs[] = {
+	"A.gif", "D.gif", "E.gif", "G.gif", "H.gif", "L.gif", "N.gif", "X.gif"
+    };
+    int r, c;
+
+
+    while (more(gp))
+    {
+	fputs("<table>\n", gp->fp);
+	for (r = 0; r < 1000 && more(gp); r++)
+	{
+	    fputs("<tr>", gp->fp);
+	    cell(gp, NULL);
+	    for (c = 0; c < 24; c++)
+	    {
+		fprintf(gp->fp, "<td><a href=\"book?c=%d\"><img src=\"/img/%s\" alt=\"\"></a></td>",
+			c, imgs[rnd(gp, sizeof(imgs)/sizeof(imgs[0]))]);
+		++gp->cells;
+	    }
+	    fputs("</tr>\n", gp->fp);
+	}
+	fputs("</table>\n", gp->fp);
+    }
+}
+
+
+static struct {
+    const char *name;
+    void (*fun)(GEN *gp);
+} kinds[] = {
+    { "wide",    gen_wide },
+    { "deep",    gen_deep },
+    { "entity",  gen_entity },
+    { "span",    gen_span },
+    { "small",   gen_small },
+    { "comment", gen_comment },
+    { "script",  gen_script },
+    { "img",     gen_img },
+    { NULL,      NULL }
+};
+
+
+int
+main(int argc,
+     char *argv[])
+{
+    GEN gb;
+    char *path = NULL;
+    int i, c;
+    unsigned long seed = 4711;
+
+
+    while ((c = getopt(argc, argv, "s:o:")) != -1)
+	switch (c)
+	{
+	  case 's':
+	    seed = strtoul(optarg, NULL, 0);
+	    break;
+	  case 'o':
+	    path = optarg;
+	    break;
+	  default:
+	    goto Usage;
+	}
+
+    if (!path || argc-optind != 2)
+	goto Usage;
+
+    for (i = 0; kinds[i].name && strcmp(kinds[i].name, argv[optind]) != 0; i++)
+	;
+    if (!kinds[i].name)
+    {
+	fprintf(stderr, "%s: %s: Unknown kind\n", argv[0], argv[optind]);
+	exit(1);
+    }
+
+    memset(&gb, 0, sizeof(gb));
+    gb.size = (long long) (atof(argv[optind+1])*1024*1024);
+    gb.rnd = seed;
+    gb.fp = fopen(path, "w");
+    if (!gb.fp)
+    {
+	fprintf(stderr, "%s: %s: Error opening output file: %s\n", argv[0], path, strerror(errno));
+	exit(1);
+    }
+
+    /* Filled in at the end, when the number of cells is known */
+    fprintf(gb.fp, "%-*s\n", HEADER_LEN-1, "<!-- -->");
+    fputs("<html><body>\n", gb.fp);
+    kinds[i].fun(&gb);
+    fputs("</body></html>\n", gb.fp);
+
+    rewind(gb.fp);
+    fprintf(gb.fp, "<!-- phtx-bench %s cells=%lld -->", kinds[i].name, gb.cells);
+
+    if (fclose(gb.fp) != 0)
+    {
+	fprintf(stderr, "%s: %s: Error writing output file: %s\n", argv[0], path, strerror(errno));
+	exit(1);
+    }
+
+    return 0;
+
+  Usage:
+    fprintf(stderr, "Usage: %s [-s seed] -o file kind size-MB\n", argv[0]);
+    fputs("Kinds:", stderr);
+    for (i = 0; kinds[i].name; i++)
+	fprintf(stderr, " %s", kinds[i].name);
+    putc('\n', stderr);
+    exit(1);
+}
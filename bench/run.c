@@ -0,0 +1,163 @@
+/*
+** run.c - Run phtx on a benchmark input and report its speed
+**
+** Runs the command 'reps' times with the input file as the last
+** argument and the output thrown away, and prints the best throughput
+** (input MB/s and cells/s, the cell count is taken from the header
+** written by gen) and the peak resident set size.
+**
+** Usage: run [-n reps] [-l label] input command [args ...]
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+
+/* Number of cells from the "<!-- phtx-bench kind cells=N -->" header */
+static long long
+input_cells(const char *path)
+{
+    FILE *fp;
+    char buf[128], *cp;
+    long long n = 0;
+
+
+    fp = fopen(path, "r");
+    if (!fp)
+	return 0;
+
+    if (fgets(buf, sizeof(buf), fp) && (cp = strstr(buf, "cells=")) != NULL)
+	n = atoll(cp+6);
+
+    fclose(fp);
+    return n;
+}
+
+
+static double
+now(void)
+{
+    struct timespec ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+
+/* Run the command once, returns the wall clock time or -1 */
+static double
+run_once(char **av,
+	 long *rssp)
+{
+    pid_t pid;
+    int fd, status;
+    struct rusage ru;
+    double t0;
+
+
+    t0 = now();
+    pid = fork();
+    if (pid < 0)
+	return -1;
+
+    if (pid == 0)
+    {
+	fd = open("/dev/null", O_WRONLY);
+	if (fd >= 0)
+	    dup2(fd, 1);
+	execvp(av[0], av);
+	fprintf(stderr, "%s: Error running: %s\n", av[0], strerror(errno));
+	_exit(127);
+    }
+
+    if (wait4(pid, &status, 0, &ru) < 0)
+	return -1;
+
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+	return -1;
+
+    *rssp = ru.ru_maxrss; /* KB on Linux */
+    return now()-t0;
+}
+
+
+int
+main(int argc,
+     char *argv[])
+{
+    char **av;
+    char *label = "";
+    const char *input;
+    struct stat sb;
+    long long cells;
+    long rss, max_rss = 0;
+    double t, best = -1;
+    int c, i, reps = 3, na;
+
+
+    while ((c = getopt(argc, argv, "+n:l:")) != -1)
+	switch (c)
+	{
+	  case 'n':
+	    reps = atoi(optarg);
+	    break;
+	  case 'l':
+	    label = optarg;
+	    break;
+	  default:
+	    goto Usage;
+	}
+
+    if (argc-optind < 2 || reps < 1)
+	goto Usage;
+
+    input = argv[optind];
+    if (stat(input, &sb) < 0)
+    {
+	fprintf(stderr, "%s: %s: %s\n", argv[0], input, strerror(errno));
+	exit(1);
+    }
+    cells = input_cells(input);
+
+    /* The command, with the input file last */
+    na = argc-optind-1;
+    av = calloc(na+2, sizeof(char *));
+    if (!av)
+	exit(1);
+    for (i = 0; i < na; i++)
+	av[i] = argv[optind+1+i];
+    av[na] = (char *) input;
+
+    for (i = 0; i < reps; i++)
+    {
+	t = run_once(av, &rss);
+	if (t < 0)
+	{
+	    fprintf(stderr, "%s: %s: Command failed\n", argv[0], label);
+	    exit(1);
+	}
+	if (best < 0 || t < best)
+	    best = t;
+	if (rss > max_rss)
+	    max_rss = rss;
+    }
+
+    printf("%-24s %8.1f MB/s %8.2f Mcells/s %8ld KB RSS\n",
+	   label, sb.st_size/best/(1024*1024), cells/best/1e6, max_rss);
+    return 0;
+
+  Usage:
+    fprintf(stderr, "Usage: %s [-n reps] [-l label] input command [args ...]\n", argv[0]);
+    exit(1);
+}
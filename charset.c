@@ -0,0 +1,355 @@
+/*
+** charset.c - Input charset detection and transcoding to UTF-8
+**
+** Cell text is kept in UTF-8 internally. The input charset is taken
+** from the -i option, a byte order mark or a <meta charset> (in that
+** order) and defaults to UTF-8. Invalid UTF-8 bytes are read as
+** Windows-1252 (like browsers do for ISO-8859-1), so old Latin-1
+** pages without a charset declaration still come out right.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+
+#include "charset.h"
+#include "scan.h"
+
+/* How far into the document to look for a <meta charset> */
+#define SNIFF_LEN 1024
+
+
+static struct {
+    const char *name;
+    int cs;
+} cs_names[] = {
+    { "utf-8",             CS_UTF8 },
+    { "utf8",              CS_UTF8 },
+    { "unicode-1-1-utf-8", CS_UTF8 },
+    { "iso-8859-1",        CS_LATIN1 },
+    { "iso8859-1",         CS_LATIN1 },
+    { "iso_8859-1",        CS_LATIN1 },
+    { "latin1",            CS_LATIN1 },
+    { "latin-1",           CS_LATIN1 },
+    { "l1",                CS_LATIN1 },
+    { "us-ascii",          CS_LATIN1 },
+    { "ascii",             CS_LATIN1 },
+    { "windows-1252",      CS_CP1252 },
+    { "cp1252",            CS_CP1252 },
+    { "x-cp1252",          CS_CP1252 },
+    { NULL,                -1 }
+};
+
+
+/* Windows-1252 0x80-0x9F, undefined positions map to themselves */
+static const unsigned short cp1252_hi[32] = {
+    0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+    0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+    0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+    0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+};
+
+
+/*
+** Look up a charset label (case insensitive). Returns -1 if unknown.
+*/
+int
+cs_lookup(const char *name,
+	  int len)
+{
+    int i;
+
+
+    if (len < 0)
+	len = strlen(name);
+
+    for (i = 0; cs_names[i].name; i++)
+	if (strncasecmp(cs_names[i].name, name, len) == 0 &&
+	    cs_names[i].name[len] == '\0')
+	    return cs_names[i].cs;
+
+    return -1;
+}
+
+
+const char *
+cs_name(int cs)
+{
+    switch (cs)
+    {
+      case CS_UTF8:
+	return "utf-8";
+      case CS_LATIN1:
+	return "iso-8859-1";
+      case CS_CP1252:
+	return "windows-1252";
+    }
+
+    return "?";
+}
+
+
+/*
+** Guess the charset of a document from a byte order mark or a
+** <meta charset="..."> / <meta ... content="...; charset=..."> near
+** the start. Returns -1 if nothing was found.
+*/
+int
+cs_sniff(const char *buf,
+	 size_t len)
+{
+    const char *p, *end, *te, *v;
+    int cs;
+
+
+    if (len >= 3 && memcmp(buf, "\357\273\277", 3) == 0)
+	return CS_UTF8;
+
+    end = buf + (len > SNIFF_LEN ? SNIFF_LEN : len);
+    for (p = buf; (p = memchr(p, '<', end-p)) != NULL; ++p)
+    {
+	if (end-p < 5 || strncasecmp(p+1, "meta", 4) != 0)
+	    continue;
+
+	te = memchr(p, '>', end-p);
+	if (!te)
+	    break;
+
+	for (v = p+5; v+8 <= te; v++)
+	{
+	    if (strncasecmp(v, "charset", 7) != 0)
+		continue;
+
+	    v += 7;
+	    while (v < te && isspace((unsigned char) *v))
+		++v;
+	    if (v >= te || *v != '=')
+		continue;
+
+	    ++v;
+	    while (v < te && (isspace((unsigned char) *v) || *v == '"' || *v == '\''))
+		++v;
+
+	    for (p = v; p < te && (isalnum((unsigned char) *p) || *p == '-' || *p == '_'); ++p)
+		;
+
+	    cs = cs_lookup(v, p-v);
+	    if (cs >= 0)
+		return cs;
+	    break;
+	}
+	p = te;
+    }
+
+    return -1;
+}
+
+
+int
+cp1252_decode(int c)
+{
+    if (c >= 0x80 && c <= 0x9F)
+	return cp1252_hi[c-0x80];
+
+    return c;
+}
+
+
+/*
+** Encode a code point for output in charset 'cs' (not UTF-8). Returns
+** the byte or -1 if it can not be represented.
+*/
+int
+cs_encode(int c,
+	  int cs)
+{
+    int i;
+
+
+    if (c < 0x80 || (c >= 0xA0 && c <= 0xFF))
+	return c;
+
+    if (cs == CS_LATIN1)
+	return c <= 0xFF ? c : -1;
+
+    for (i = 0; i < 32; i++)
+	if (cp1252_hi[i] == c)
+	    return 0x80+i;
+
+    return -1;
+}
+
+
+/*
+** Store code point 'c' as UTF-8 at 'buf'. Returns the number of bytes.
+*/
+int
+utf8_encode(char *buf,
+	    int c)
+{
+    if (c < 0x80)
+    {
+	buf[0] = c;
+	return 1;
+    }
+
+    if (c < 0x800)
+    {
+	buf[0] = 0xC0 | (c >> 6);
+	buf[1] = 0x80 | (c & 0x3F);
+	return 2;
+    }
+
+    if (c < 0x10000)
+    {
+	buf[0] = 0xE0 | (c >> 12);
+	buf[1] = 0x80 | ((c >> 6) & 0x3F);
+	buf[2] = 0x80 | (c & 0x3F);
+	return 3;
+    }
+
+    buf[0] = 0xF0 | (c >> 18);
+    buf[1] = 0x80 | ((c >> 12) & 0x3F);
+    buf[2] = 0x80 | ((c >> 6) & 0x3F);
+    buf[3] = 0x80 | (c & 0x3F);
+    return 4;
+}
+
+
+/*
+** Decode one UTF-8 sequence at 'buf'. Returns its length, or 0 if it
+** is not valid (truncated, overlong, surrogate or out of range).
+*/
+int
+utf8_decode(const char *buf,
+	    const char *end,
+	    int *cp)
+{
+    const unsigned char *p = (const unsigned char *) buf;
+    int c, n, i, min;
+
+
+    if (buf >= end)
+	return 0;
+
+    c = p[0];
+    if (c < 0x80)
+    {
+	*cp = c;
+	return 1;
+    }
+
+    if (c >= 0xC2 && c <= 0xDF)
+    {
+	n = 2;
+	c &= 0x1F;
+	min = 0x80;
+    }
+    else if (c >= 0xE0 && c <= 0xEF)
+    {
+	n = 3;
+	c &= 0x0F;
+	min = 0x800;
+    }
+    else if (c >= 0xF0 && c <= 0xF4)
+    {
+	n = 4;
+	c &= 0x07;
+	min = 0x10000;
+    }
+    else
+	return 0;
+
+    if (end-buf < n)
+	return 0;
+
+    for (i = 1; i < n; i++)
+    {
+	if ((p[i] & 0xC0) != 0x80)
+	    return 0;
+	c = (c << 6) | (p[i] & 0x3F);
+    }
+
+    if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF))
+	return 0;
+
+    *cp = c;
+    return n;
+}
+
+
+/*
+** Transcode 'len' bytes of text in charset 'cs' to UTF-8 at 'dst'
+** (which must have room for 3*len bytes). Runs of plain ASCII are
+** found with the vectorized scanner and copied as is. Returns the
+** number of bytes stored.
+*/
+int
+cs_transcode(char *dst,
+	     const char *src,
+	     int len,
+	     int cs)
+{
+    char *dp = dst;
+    const char *end = src+len, *p;
+    int c, n;
+
+
+    while (src < end)
+    {
+	p = scan_high(src, end);
+	memcpy(dp, src, p-src);
+	dp += p-src;
+	src = p;
+
+	while (src < end && (*src & 0x80))
+	{
+	    if (cs == CS_UTF8 && (n = utf8_decode(src, end, &c)) > 0)
+	    {
+		memcpy(dp, src, n);
+		dp += n;
+		src += n;
+		continue;
+	    }
+
+	    dp += utf8_encode(dp, cp1252_decode((unsigned char) *src++));
+	}
+    }
+
+    return dp-dst;
+}
+
+
+/*
+** Check if cs_transcode() would leave 'len' bytes of text in charset
+** 'cs' unchanged (plain ASCII, or valid UTF-8 in UTF-8 input).
+*/
+int
+cs_unchanged(const char *src,
+	     int len,
+	     int cs)
+{
+    const char *end = src+len;
+    int c, n;
+
+
+    src = scan_high(src, end);
+    if (src == end)
+	return 1;
+
+    if (cs != CS_UTF8)
+	return 0;
+
+    while (src < end)
+    {
+	n = utf8_decode(src, end, &c);
+	if (n == 0)
+	    return 0;
+	
+	src = scan_high(src+n, end);
+    }
+
+    return 1;
+}
@@ -0,0 +1,49 @@
+/* charset.h */
+
+#ifndef PHTX_CHARSET_H
+#define PHTX_CHARSET_H
+
+#define CS_UTF8   0
+#define CS_LATIN1 1 /* ISO-8859-1 (read as Windows-1252, like browsers do) */
+#define CS_CP1252 2 /* Windows-1252 */
+
+
+extern int
+cs_lookup(const char *name,
+	  int len);
+
+extern const char *
+cs_name(int cs);
+
+extern int
+cs_sniff(const char *buf,
+	 size_t len);
+
+extern int
+cp1252_decode(int c);
+
+extern int
+cs_encode(int c,
+	  int cs);
+
+extern int
+utf8_encode(char *buf,
+	    int c);
+
+extern int
+utf8_decode(const char *buf,
+	    const char *end,
+	    int *cp);
+
+extern int
+cs_unchanged(const char *src,
+	     int len,
+	     int cs);
+
+extern int
+cs_transcode(char *dst,
+	     const char *src,
+	     int len,
+	     int cs);
+
+#endif
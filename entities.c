@@ -4,112 +4,117 @@
 #include <ctype.h>
 
 #include "entities.h"
+#include "charset.h"
+#include "entities_html5.h"
 
 extern int debug;
 
+/* Longest character reference we look for, "&" and ";" included */
+#define ENT_MAXLEN 40
+
 ENTITY iso88591_ev[] = {
-    {  34, "&quot;" },
-    {  39, "&apos;" },
-    {  38, "&amp;" },
-    {  60, "&lt;" },
-    {  62, "&gt;" },
-    { 160, "&nbsp;" },
-    { 161, "&iexcl;" },
-    { 162, "&cent;" },
-    { 163, "&pound;" },
-    { 164, "&curren;" },
-    { 165, "&yen;" },
-    { 166, "&brvbar;" },
-    { 167, "&sect;" },
-    { 168, "&uml;" },
-    { 169, "&copy;" },
-    { 170, "&ordf;" },
-    { 171, "&laquo;" },
-    { 172, "&not;" },
-    { 173, "&shy;" },
-    { 174, "&reg;" },
-    { 175, "&macr;" },
-    { 176, "&deg;" },
-    { 177, "&plusmn;" },
-    { 178, "&sup2;" },
-    { 179, "&sup3;" },
-    { 180, "&acute;" },
-    { 181, "&micro;" },
-    { 182, "&para;" },
-    { 183, "&middot;" },
-    { 184, "&cedil;" },
-    { 185, "&sup1;" },
-    { 186, "&ordm;" },
-    { 187, "&raquo;" },
-    { 188, "&frac14;" },
-    { 189, "&frac12;" },
-    { 190, "&frac34;" },
-    { 191, "&iquest;" },
-    { 215, "&times;" },
-    { 247, "&divide;" },
-    { 192, "&Agrave;" },
-    { 193, "&Aacute;" },
-    { 194, "&Acirc;" },
-    { 195, "&Atilde;" },
-    { 196, "&Auml;" },
-    { 197, "&Aring;" },
-    { 198, "&AElig;" },  
-    { 199, "&Ccedil;" },
-    { 200, "&Egrave;" },
-    { 201, "&Eacute;" }, 
-    { 202, "&Ecirc;" },
-    { 203, "&Euml;" },
-    { 204, "&Igrave;" },
-    { 205, "&Iacute;" },
-    { 206, "&Icirc;" },
-    { 207, "&Iuml;" },
-    { 208, "&ETH;" },
-    { 209, "&Ntilde;" },
-    { 210, "&Ograve;" },
-    { 211, "&Oacute;" },
-    { 212, "&Ocirc;" },
-    { 213, "&Otilde;" },
-    { 214, "&Ouml;" },
-    { 216, "&Oslash;" },
-    { 217, "&Ugrave;" },
-    { 218, "&Uacute;" },
-    { 219, "&Ucirc;" },
-    { 220, "&Uuml;" },
-    { 221, "&Yacute;" },
-    { 222, "&THORN;" },
-    { 223, "&szlig;" },
-    { 224, "&agrave;" },
-    { 225, "&aacute;" },
-    { 226, "&acirc;" },
-    { 227, "&atilde;" },
-    { 228, "&auml;" },
-    { 229, "&aring;" },
-    { 230, "&aelig;" },
-    { 231, "&ccedil;" },
-    { 232, "&egrave;" },
-    { 233, "&eacute;" },
-    { 234, "&ecirc;" },
-    { 235, "&euml;" },
-    { 236, "&igrave;" },
-    { 237, "&iacute;" },
-    { 238, "&icirc;" },
-    { 239, "&iuml;" },
-    { 240, "&eth;" }, 
-    { 241 ,"ntilde;" },
-    { 242, "&ograve;" },
-    { 243, "&oacute;" },
-    { 244, "&ocirc;" },
-    { 245, "&otilde;" },
-    { 246, "&ouml;" },
-    { 248, "&oslash;" },
-    { 249, "&ugrave;" },
-    { 250, "&uacute;" },
-    { 251, "&ucirc;" },
-    { 252, "&uuml;" },
-    { 253, "&yacute;" },
-    { 254, "&thorn;" },
-    { 255, "&yuml;" },
-    { 0, NULL }
+    {  34, "&quot;", 0 },
+    {  39, "&apos;", 0 },
+    {  38, "&amp;", 0 },
+    {  60, "&lt;", 0 },
+    {  62, "&gt;", 0 },
+    { 160, "&nbsp;", 0 },
+    { 161, "&iexcl;", 0 },
+    { 162, "&cent;", 0 },
+    { 163, "&pound;", 0 },
+    { 164, "&curren;", 0 },
+    { 165, "&yen;", 0 },
+    { 166, "&brvbar;", 0 },
+    { 167, "&sect;", 0 },
+    { 168, "&uml;", 0 },
+    { 169, "&copy;", 0 },
+    { 170, "&ordf;", 0 },
+    { 171, "&laquo;", 0 },
+    { 172, "&not;", 0 },
+    { 173, "&shy;", 0 },
+    { 174, "&reg;", 0 },
+    { 175, "&macr;", 0 },
+    { 176, "&deg;", 0 },
+    { 177, "&plusmn;", 0 },
+    { 178, "&sup2;", 0 },
+    { 179, "&sup3;", 0 },
+    { 180, "&acute;", 0 },
+    { 181, "&micro;", 0 },
+    { 182, "&para;", 0 },
+    { 183, "&middot;", 0 },
+    { 184, "&cedil;", 0 },
+    { 185, "&sup1;", 0 },
+    { 186, "&ordm;", 0 },
+    { 187, "&raquo;", 0 },
+    { 188, "&frac14;", 0 },
+    { 189, "&frac12;", 0 },
+    { 190, "&frac34;", 0 },
+    { 191, "&iquest;", 0 },
+    { 215, "&times;", 0 },
+    { 247, "&divide;", 0 },
+    { 192, "&Agrave;", 0 },
+    { 193, "&Aacute;", 0 },
+    { 194, "&Acirc;", 0 },
+    { 195, "&Atilde;", 0 },
+    { 196, "&Auml;", 0 },
+    { 197, "&Aring;", 0 },
+    { 198, "&AElig;", 0 },  
+    { 199, "&Ccedil;", 0 },
+    { 200, "&Egrave;", 0 },
+    { 201, "&Eacute;", 0 }, 
+    { 202, "&Ecirc;", 0 },
+    { 203, "&Euml;", 0 },
+    { 204, "&Igrave;", 0 },
+    { 205, "&Iacute;", 0 },
+    { 206, "&Icirc;", 0 },
+    { 207, "&Iuml;", 0 },
+    { 208, "&ETH;", 0 },
+    { 209, "&Ntilde;", 0 },
+    { 210, "&Ograve;", 0 },
+    { 211, "&Oacute;", 0 },
+    { 212, "&Ocirc;", 0 },
+    { 213, "&Otilde;", 0 },
+    { 214, "&Ouml;", 0 },
+    { 216, "&Oslash;", 0 },
+    { 217, "&Ugrave;", 0 },
+    { 218, "&Uacute;", 0 },
+    { 219, "&Ucirc;", 0 },
+    { 220, "&Uuml;", 0 },
+    { 221, "&Yacute;", 0 },
+    { 222, "&THORN;", 0 },
+    { 223, "&szlig;", 0 },
+    { 224, "&agrave;", 0 },
+    { 225, "&aacute;", 0 },
+    { 226, "&acirc;", 0 },
+    { 227, "&atilde;", 0 },
+    { 228, "&auml;", 0 },
+    { 229, "&aring;", 0 },
+    { 230, "&aelig;", 0 },
+    { 231, "&ccedil;", 0 },
+    { 232, "&egrave;", 0 },
+    { 233, "&eacute;", 0 },
+    { 234, "&ecirc;", 0 },
+    { 235, "&euml;", 0 },
+    { 236, "&igrave;", 0 },
+    { 237, "&iacute;", 0 },
+    { 238, "&icirc;", 0 },
+    { 239, "&iuml;", 0 },
+    { 240, "&eth;", 0 }, 
+    { 241, "&ntilde;", 0 },
+    { 242, "&ograve;", 0 },
+    { 243, "&oacute;", 0 },
+    { 244, "&ocirc;", 0 },
+    { 245, "&otilde;", 0 },
+    { 246, "&ouml;", 0 },
+    { 248, "&oslash;", 0 },
+    { 249, "&ugrave;", 0 },
+    { 250, "&uacute;", 0 },
+    { 251, "&ucirc;", 0 },
+    { 252, "&uuml;", 0 },
+    { 253, "&yacute;", 0 },
+    { 254, "&thorn;", 0 },
+    { 255, "&yuml;", 0 },
+    { 0, NULL, 0 }
 };
 
 
@@ -142,93 +147,185 @@ str_compare(const char *s1,
     return d;
 }
 
-int
-str2ent(const char *str,
-	int len)
+/*
+** Parse the digits of a numeric character reference. Invalid or out
+** of range values give U+FFFD and 128-159 are read as Windows-1252,
+** like in a browser.
+*/
+static int
+num_parse(const char *str,
+	  int len)
 {
-    int i, d = -1;
+    int i, d, base = 10;
+    long v = 0;
 
-    
-    if (len < 0)
-	len = strlen(str);
 
-    if (sscanf(str, "&#x%x;", &d) == 1)
-	return d;
-    
-    if (sscanf(str, "&#%u;", &d) == 1)
-	return d;
+    if (len > 0 && (*str == 'x' || *str == 'X'))
+    {
+	base = 16;
+	++str;
+	--len;
+    }
+
+    if (len <= 0)
+	return -1;
     
-    for (i = 0; d == -1 && iso88591_ev[i].name; ++i)
-	if (str_compare(iso88591_ev[i].name, str, len, 0) == 0)
-	    return iso88591_ev[i].c;
+    for (i = 0; i < len; i++)
+    {
+	if (str[i] >= '0' && str[i] <= '9')
+	    d = str[i]-'0';
+	else if (base == 16 && str[i] >= 'a' && str[i] <= 'f')
+	    d = str[i]-'a'+10;
+	else if (base == 16 && str[i] >= 'A' && str[i] <= 'F')
+	    d = str[i]-'A'+10;
+	else
+	    return -1;
 
-    for (i = 0; d == -1 && iso88591_ev[i].name; ++i)
-	if (str_compare(iso88591_ev[i].name, str, len, 1) == 0)
-	    return iso88591_ev[i].c;
+	if (v <= 0x10FFFF)
+	    v = v*base + d;
+    }
 
-    return -1;
+    if (v == 0 || v > 0x10FFFF || (v >= 0xD800 && v <= 0xDFFF))
+	return 0xFFFD;
+    
+    return cp1252_decode((int) v);
 }
 
-const char *
-ent2str(int c)
+
+/*
+** Binary search for an HTML5 entity name (without '&' and ';') within
+** the range of names sharing its first character.
+*/
+static const ENTITY *
+html5_lookup(const char *name,
+	     int len)
 {
-    int i;
+    int lo, hi, mid, d;
+    unsigned char c = (unsigned char) name[0];
 
-    for (i = 0; iso88591_ev[i].name; ++i)
-	if (iso88591_ev[i].c == c)
-	    return iso88591_ev[i].name;
+
+    if (len <= 0 || len > HTML5_MAXLEN || c >= 128)
+	return NULL;
+    
+    lo = html5_idx[c];
+    hi = html5_idx[c+1];
+    while (lo < hi)
+    {
+	mid = (lo+hi)/2;
+	d = strncmp(html5_ev[mid].name, name, len);
+	if (d == 0 && html5_ev[mid].name[len] != '\0')
+	    d = 1;
+	
+	if (d == 0)
+	    return &html5_ev[mid];
+	if (d < 0)
+	    lo = mid+1;
+	else
+	    hi = mid;
+    }
 
     return NULL;
 }
 
-char *
-ent_decode(const char *str,
-	   int len)
-{
-    char *buf, *bp;
-    int i, j, c;
-    
 
-    if (!str)
-	return NULL;
+/*
+** Decode a character reference ("&name;", "&#nnn;" or "&#xhhh;") of
+** 'len' bytes. Returns the code point or -1 if unknown. A few named
+** references expand to two code points, the second is stored in *c2
+** (0 otherwise) if c2 is not NULL.
+*/
+int
+str2ent(const char *str,
+	int len,
+	int *c2)
+{
+    int i;
+    const ENTITY *ep;
 
+    
+    if (c2)
+	*c2 = 0;
+    
     if (len < 0)
 	len = strlen(str);
+
+    if (len < 3 || str[0] != '&' || str[len-1] != ';')
+	return -1;
     
-    buf = malloc(len+1);
-    if (!buf)
-	return NULL;
+    if (str[1] == '#')
+	return num_parse(str+2, len-3);
 
-    bp = buf;
+    ep = html5_lookup(str+1, len-2);
+    if (ep)
+    {
+	if (c2)
+	    *c2 = ep->c2;
+	return ep->c;
+    }
 
-    for (i = 0; i < len; i++)
+    /* Be forgiving about case for the classic Latin-1 names */
+    for (i = 0; iso88591_ev[i].name; ++i)
+	if (str_compare(iso88591_ev[i].name, str, len, 1) == 0)
+	    return iso88591_ev[i].c;
+
+    return -1;
+}
+
+
+/*
+** Decode the character references in 'len' bytes of text in charset
+** 'cs' into UTF-8 at 'dst', which must have room for 3*len+1 bytes.
+** Returns the length of the (NUL terminated) result. The number of
+** references decoded is added to *nrefs (unless NULL).
+*/
+int
+ent_decode_buf(char *dst,
+	       const char *str,
+	       int len,
+	       int cs,
+	       int *nrefs)
+{
+    char *bp;
+    const char *end, *ap, *sc;
+    int c, c2;
+    
+
+    bp = dst;
+    end = str+len;
+
+    while (str < end)
     {
-	switch (str[i])
+	/* Transcode everything up to the next '&' in one go */
+	ap = memchr(str, '&', end-str);
+	if (!ap)
 	{
-	  case '&':
-	    for (j = i+1; j < len && str[j] != ';'; ++j)
-		;
-	    if (j >= len)
-		*bp++ = str[i];
-	    else
-	    {
-		c = str2ent(str+i, j-i+1);
-		if (debug > 2)
-		    printf("str2ent: %.*s -> %c (%d)\n", j-i+1, str+i, c, c);
-		
-		if (c < 0)
-		    c = '?';
-		else
-		    *bp++ = c;
-		i = j;
-	    }
+	    bp += cs_transcode(bp, str, end-str, cs);
 	    break;
+	}
+
+	bp += cs_transcode(bp, str, ap-str, cs);
 
-	  default:
-	    *bp++ = str[i];
+	sc = memchr(ap+1, ';', (end-ap > ENT_MAXLEN ? ENT_MAXLEN : end-ap) - 1);
+	c = sc ? str2ent(ap, sc-ap+1, &c2) : -1;
+	if (debug > 2)
+	    fprintf(stderr, "str2ent: %.*s -> %d\n", sc ? (int) (sc-ap+1) : 1, ap, c);
+
+	if (c < 0)
+	{
+	    /* Not a character reference - keep the '&' as is */
+	    *bp++ = *ap;
+	    str = ap+1;
+	    continue;
 	}
+
+	bp += utf8_encode(bp, c);
+	if (nrefs)
+	    ++*nrefs;
+	if (c2)
+	    bp += utf8_encode(bp, c2);
+	str = sc+1;
     }
     
     *bp = '\0';
-    return buf;
+    return bp-dst;
 }
@@ -6,17 +6,18 @@
 typedef struct entity {
     int c;
     char *name;
+    int c2;      /* Second code point (or 0) */
 } ENTITY;
 
 
 extern int
-str2ent(const char *str, int len);
+str2ent(const char *str, int len, int *c2);
 
-extern const char *
-ent2str(int c);
-
-extern char *
-ent_decode(const char *str,
-	   int len);
+extern int
+ent_decode_buf(char *dst,
+	       const char *str,
+	       int len,
+	       int cs,
+	       int *nrefs);
 
 #endif
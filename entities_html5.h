@@ -0,0 +1,2155 @@
+/* entities_html5.h - generated by mkentities.py, do not edit */
+
+/* HTML5 named character references, sorted by name */
+static const ENTITY html5_ev[] = {
+    {    198, "AElig", 0 },
+    {     38, "AMP", 0 },
+    {    193, "Aacute", 0 },
+    {    258, "Abreve", 0 },
+    {    194, "Acirc", 0 },
+    {   1040, "Acy", 0 },
+    { 120068, "Afr", 0 },
+    {    192, "Agrave", 0 },
+    {    913, "Alpha", 0 },
+    {    256, "Amacr", 0 },
+    {  10835, "And", 0 },
+    {    260, "Aogon", 0 },
+    { 120120, "Aopf", 0 },
+    {   8289, "ApplyFunction", 0 },
+    {    197, "Aring", 0 },
+    { 119964, "Ascr", 0 },
+    {   8788, "Assign", 0 },
+    {    195, "Atilde", 0 },
+    {    196, "Auml", 0 },
+    {   8726, "Backslash", 0 },
+    {  10983, "Barv", 0 },
+    {   8966, "Barwed", 0 },
+    {   1041, "Bcy", 0 },
+    {   8757, "Because", 0 },
+    {   8492, "Bernoullis", 0 },
+    {    914, "Beta", 0 },
+    { 120069, "Bfr", 0 },
+    { 120121, "Bopf", 0 },
+    {    728, "Breve", 0 },
+    {   8492, "Bscr", 0 },
+    {   8782, "Bumpeq", 0 },
+    {   1063, "CHcy", 0 },
+    {    169, "COPY", 0 },
+    {    262, "Cacute", 0 },
+    {   8914, "Cap", 0 },
+    {   8517, "CapitalDifferentialD", 0 },
+    {   8493, "Cayleys", 0 },
+    {    268, "Ccaron", 0 },
+    {    199, "Ccedil", 0 },
+    {    264, "Ccirc", 0 },
+    {   8752, "Cconint", 0 },
+    {    266, "Cdot", 0 },
+    {    184, "Cedilla", 0 },
+    {    183, "CenterDot", 0 },
+    {   8493, "Cfr", 0 },
+    {    935, "Chi", 0 },
+    {   8857, "CircleDot", 0 },
+    {   8854, "CircleMinus", 0 },
+    {   8853, "CirclePlus", 0 },
+    {   8855, "CircleTimes", 0 },
+    {   8754, "ClockwiseContourIntegral", 0 },
+    {   8221, "CloseCurlyDoubleQuote", 0 },
+    {   8217, "CloseCurlyQuote", 0 },
+    {   8759, "Colon", 0 },
+    {  10868, "Colone", 0 },
+    {   8801, "Congruent", 0 },
+    {   8751, "Conint", 0 },
+    {   8750, "ContourIntegral", 0 },
+    {   8450, "Copf", 0 },
+    {   8720, "Coproduct", 0 },
+    {   8755, "CounterClockwiseContourIntegral", 0 },
+    {  10799, "Cross", 0 },
+    { 119966, "Cscr", 0 },
+    {   8915, "Cup", 0 },
+    {   8781, "CupCap", 0 },
+    {   8517, "DD", 0 },
+    {  10513, "DDotrahd", 0 },
+    {   1026, "DJcy", 0 },
+    {   1029, "DScy", 0 },
+    {   1039, "DZcy", 0 },
+    {   8225, "Dagger", 0 },
+    {   8609, "Darr", 0 },
+    {  10980, "Dashv", 0 },
+    {    270, "Dcaron", 0 },
+    {   1044, "Dcy", 0 },
+    {   8711, "Del", 0 },
+    {    916, "Delta", 0 },
+    { 120071, "Dfr", 0 },
+    {    180, "DiacriticalAcute", 0 },
+    {    729, "DiacriticalDot", 0 },
+    {    733, "DiacriticalDoubleAcute", 0 },
+    {     96, "DiacriticalGrave", 0 },
+    {    732, "DiacriticalTilde", 0 },
+    {   8900, "Diamond", 0 },
+    {   8518, "DifferentialD", 0 },
+    { 120123, "Dopf", 0 },
+    {    168, "Dot", 0 },
+    {   8412, "DotDot", 0 },
+    {   8784, "DotEqual", 0 },
+    {   8751, "DoubleContourIntegral", 0 },
+    {    168, "DoubleDot", 0 },
+    {   8659, "DoubleDownArrow", 0 },
+    {   8656, "DoubleLeftArrow", 0 },
+    {   8660, "DoubleLeftRightArrow", 0 },
+    {  10980, "DoubleLeftTee", 0 },
+    {  10232, "DoubleLongLeftArrow", 0 },
+    {  10234, "DoubleLongLeftRightArrow", 0 },
+    {  10233, "DoubleLongRightArrow", 0 },
+    {   8658, "DoubleRightArrow", 0 },
+    {   8872, "DoubleRightTee", 0 },
+    {   8657, "DoubleUpArrow", 0 },
+    {   8661, "DoubleUpDownArrow", 0 },
+    {   8741, "DoubleVerticalBar", 0 },
+    {   8595, "DownArrow", 0 },
+    {  10515, "DownArrowBar", 0 },
+    {   8693, "DownArrowUpArrow", 0 },
+    {    785, "DownBreve", 0 },
+    {  10576, "DownLeftRightVector", 0 },
+    {  10590, "DownLeftTeeVector", 0 },
+    {   8637, "DownLeftVector", 0 },
+    {  10582, "DownLeftVectorBar", 0 },
+    {  10591, "DownRightTeeVector", 0 },
+    {   8641, "DownRightVector", 0 },
+    {  10583, "DownRightVectorBar", 0 },
+    {   8868, "DownTee", 0 },
+    {   8615, "DownTeeArrow", 0 },
+    {   8659, "Downarrow", 0 },
+    { 119967, "Dscr", 0 },
+    {    272, "Dstrok", 0 },
+    {    330, "ENG", 0 },
+    {    208, "ETH", 0 },
+    {    201, "Eacute", 0 },
+    {    282, "Ecaron", 0 },
+    {    202, "Ecirc", 0 },
+    {   1069, "Ecy", 0 },
+    {    278, "Edot", 0 },
+    { 120072, "Efr", 0 },
+    {    200, "Egrave", 0 },
+    {   8712, "Element", 0 },
+    {    274, "Emacr", 0 },
+    {   9723, "EmptySmallSquare", 0 },
+    {   9643, "EmptyVerySmallSquare", 0 },
+    {    280, "Eogon", 0 },
+    { 120124, "Eopf", 0 },
+    {    917, "Epsilon", 0 },
+    {  10869, "Equal", 0 },
+    {   8770, "EqualTilde", 0 },
+    {   8652, "Equilibrium", 0 },
+    {   8496, "Escr", 0 },
+    {  10867, "Esim", 0 },
+    {    919, "Eta", 0 },
+    {    203, "Euml", 0 },
+    {   8707, "Exists", 0 },
+    {   8519, "ExponentialE", 0 },
+    {   1060, "Fcy", 0 },
+    { 120073, "Ffr", 0 },
+    {   9724, "FilledSmallSquare", 0 },
+    {   9642, "FilledVerySmallSquare", 0 },
+    { 120125, "Fopf", 0 },
+    {   8704, "ForAll", 0 },
+    {   8497, "Fouriertrf", 0 },
+    {   8497, "Fscr", 0 },
+    {   1027, "GJcy", 0 },
+    {     62, "GT", 0 },
+    {    915, "Gamma", 0 },
+    {    988, "Gammad", 0 },
+    {    286, "Gbreve", 0 },
+    {    290, "Gcedil", 0 },
+    {    284, "Gcirc", 0 },
+    {   1043, "Gcy", 0 },
+    {    288, "Gdot", 0 },
+    { 120074, "Gfr", 0 },
+    {   8921, "Gg", 0 },
+    { 120126, "Gopf", 0 },
+    {   8805, "GreaterEqual", 0 },
+    {   8923, "GreaterEqualLess", 0 },
+    {   8807, "GreaterFullEqual", 0 },
+    {  10914, "GreaterGreater", 0 },
+    {   8823, "GreaterLess", 0 },
+    {  10878, "GreaterSlantEqual", 0 },
+    {   8819, "GreaterTilde", 0 },
+    { 119970, "Gscr", 0 },
+    {   8811, "Gt", 0 },
+    {   1066, "HARDcy", 0 },
+    {    711, "Hacek", 0 },
+    {     94, "Hat", 0 },
+    {    292, "Hcirc", 0 },
+    {   8460, "Hfr", 0 },
+    {   8459, "HilbertSpace", 0 },
+    {   8461, "Hopf", 0 },
+    {   9472, "HorizontalLine", 0 },
+    {   8459, "Hscr", 0 },
+    {    294, "Hstrok", 0 },
+    {   8782, "HumpDownHump", 0 },
+    {   8783, "HumpEqual", 0 },
+    {   1045, "IEcy", 0 },
+    {    306, "IJlig", 0 },
+    {   1025, "IOcy", 0 },
+    {    205, "Iacute", 0 },
+    {    206, "Icirc", 0 },
+    {   1048, "Icy", 0 },
+    {    304, "Idot", 0 },
+    {   8465, "Ifr", 0 },
+    {    204, "Igrave", 0 },
+    {   8465, "Im", 0 },
+    {    298, "Imacr", 0 },
+    {   8520, "ImaginaryI", 0 },
+    {   8658, "Implies", 0 },
+    {   8748, "Int", 0 },
+    {   8747, "Integral", 0 },
+    {   8898, "Intersection", 0 },
+    {   8291, "InvisibleComma", 0 },
+    {   8290, "InvisibleTimes", 0 },
+    {    302, "Iogon", 0 },
+    { 120128, "Iopf", 0 },
+    {    921, "Iota", 0 },
+    {   8464, "Iscr", 0 },
+    {    296, "Itilde", 0 },
+    {   1030, "Iukcy", 0 },
+    {    207, "Iuml", 0 },
+    {    308, "Jcirc", 0 },
+    {   1049, "Jcy", 0 },
+    { 120077, "Jfr", 0 },
+    { 120129, "Jopf", 0 },
+    { 119973, "Jscr", 0 },
+    {   1032, "Jsercy", 0 },
+    {   1028, "Jukcy", 0 },
+    {   1061, "KHcy", 0 },
+    {   1036, "KJcy", 0 },
+    {    922, "Kappa", 0 },
+    {    310, "Kcedil", 0 },
+    {   1050, "Kcy", 0 },
+    { 120078, "Kfr", 0 },
+    { 120130, "Kopf", 0 },
+    { 119974, "Kscr", 0 },
+    {   1033, "LJcy", 0 },
+    {     60, "LT", 0 },
+    {    313, "Lacute", 0 },
+    {    923, "Lambda", 0 },
+    {  10218, "Lang", 0 },
+    {   8466, "Laplacetrf", 0 },
+    {   8606, "Larr", 0 },
+    {    317, "Lcaron", 0 },
+    {    315, "Lcedil", 0 },
+    {   1051, "Lcy", 0 },
+    {  10216, "LeftAngleBracket", 0 },
+    {   8592, "LeftArrow", 0 },
+    {   8676, "LeftArrowBar", 0 },
+    {   8646, "LeftArrowRightArrow", 0 },
+    {   8968, "LeftCeiling", 0 },
+    {  10214, "LeftDoubleBracket", 0 },
+    {  10593, "LeftDownTeeVector", 0 },
+    {   8643, "LeftDownVector", 0 },
+    {  10585, "LeftDownVectorBar", 0 },
+    {   8970, "LeftFloor", 0 },
+    {   8596, "LeftRightArrow", 0 },
+    {  10574, "LeftRightVector", 0 },
+    {   8867, "LeftTee", 0 },
+    {   8612, "LeftTeeArrow", 0 },
+    {  10586, "LeftTeeVector", 0 },
+    {   8882, "LeftTriangle", 0 },
+    {  10703, "LeftTriangleBar", 0 },
+    {   8884, "LeftTriangleEqual", 0 },
+    {  10577, "LeftUpDownVector", 0 },
+    {  10592, "LeftUpTeeVector", 0 },
+    {   8639, "LeftUpVector", 0 },
+    {  10584, "LeftUpVectorBar", 0 },
+    {   8636, "LeftVector", 0 },
+    {  10578, "LeftVectorBar", 0 },
+    {   8656, "Leftarrow", 0 },
+    {   8660, "Leftrightarrow", 0 },
+    {   8922, "LessEqualGreater", 0 },
+    {   8806, "LessFullEqual", 0 },
+    {   8822, "LessGreater", 0 },
+    {  10913, "LessLess", 0 },
+    {  10877, "LessSlantEqual", 0 },
+    {   8818, "LessTilde", 0 },
+    { 120079, "Lfr", 0 },
+    {   8920, "Ll", 0 },
+    {   8666, "Lleftarrow", 0 },
+    {    319, "Lmidot", 0 },
+    {  10229, "LongLeftArrow", 0 },
+    {  10231, "LongLeftRightArrow", 0 },
+    {  10230, "LongRightArrow", 0 },
+    {  10232, "Longleftarrow", 0 },
+    {  10234, "Longleftrightarrow", 0 },
+    {  10233, "Longrightarrow", 0 },
+    { 120131, "Lopf", 0 },
+    {   8601, "LowerLeftArrow", 0 },
+    {   8600, "LowerRightArrow", 0 },
+    {   8466, "Lscr", 0 },
+    {   8624, "Lsh", 0 },
+    {    321, "Lstrok", 0 },
+    {   8810, "Lt", 0 },
+    {  10501, "Map", 0 },
+    {   1052, "Mcy", 0 },
+    {   8287, "MediumSpace", 0 },
+    {   8499, "Mellintrf", 0 },
+    { 120080, "Mfr", 0 },
+    {   8723, "MinusPlus", 0 },
+    { 120132, "Mopf", 0 },
+    {   8499, "Mscr", 0 },
+    {    924, "Mu", 0 },
+    {   1034, "NJcy", 0 },
+    {    323, "Nacute", 0 },
+    {    327, "Ncaron", 0 },
+    {    325, "Ncedil", 0 },
+    {   1053, "Ncy", 0 },
+    {   8203, "NegativeMediumSpace", 0 },
+    {   8203, "NegativeThickSpace", 0 },
+    {   8203, "NegativeThinSpace", 0 },
+    {   8203, "NegativeVeryThinSpace", 0 },
+    {   8811, "NestedGreaterGreater", 0 },
+    {   8810, "NestedLessLess", 0 },
+    {     10, "NewLine", 0 },
+    { 120081, "Nfr", 0 },
+    {   8288, "NoBreak", 0 },
+    {    160, "NonBreakingSpace", 0 },
+    {   8469, "Nopf", 0 },
+    {  10988, "Not", 0 },
+    {   8802, "NotCongruent", 0 },
+    {   8813, "NotCupCap", 0 },
+    {   8742, "NotDoubleVerticalBar", 0 },
+    {   8713, "NotElement", 0 },
+    {   8800, "NotEqual", 0 },
+    {   8770, "NotEqualTilde", 824 },
+    {   8708, "NotExists", 0 },
+    {   8815, "NotGreater", 0 },
+    {   8817, "NotGreaterEqual", 0 },
+    {   8807, "NotGreaterFullEqual", 824 },
+    {   8811, "NotGreaterGreater", 824 },
+    {   8825, "NotGreaterLess", 0 },
+    {  10878, "NotGreaterSlantEqual", 824 },
+    {   8821, "NotGreaterTilde", 0 },
+    {   8782, "NotHumpDownHump", 824 },
+    {   8783, "NotHumpEqual", 824 },
+    {   8938, "NotLeftTriangle", 0 },
+    {  10703, "NotLeftTriangleBar", 824 },
+    {   8940, "NotLeftTriangleEqual", 0 },
+    {   8814, "NotLess", 0 },
+    {   8816, "NotLessEqual", 0 },
+    {   8824, "NotLessGreater", 0 },
+    {   8810, "NotLessLess", 824 },
+    {  10877, "NotLessSlantEqual", 824 },
+    {   8820, "NotLessTilde", 0 },
+    {  10914, "NotNestedGreaterGreater", 824 },
+    {  10913, "NotNestedLessLess", 824 },
+    {   8832, "NotPrecedes", 0 },
+    {  10927, "NotPrecedesEqual", 824 },
+    {   8928, "NotPrecedesSlantEqual", 0 },
+    {   8716, "NotReverseElement", 0 },
+    {   8939, "NotRightTriangle", 0 },
+    {  10704, "NotRightTriangleBar", 824 },
+    {   8941, "NotRightTriangleEqual", 0 },
+    {   8847, "NotSquareSubset", 824 },
+    {   8930, "NotSquareSubsetEqual", 0 },
+    {   8848, "NotSquareSuperset", 824 },
+    {   8931, "NotSquareSupersetEqual", 0 },
+    {   8834, "NotSubset", 8402 },
+    {   8840, "NotSubsetEqual", 0 },
+    {   8833, "NotSucceeds", 0 },
+    {  10928, "NotSucceedsEqual", 824 },
+    {   8929, "NotSucceedsSlantEqual", 0 },
+    {   8831, "NotSucceedsTilde", 824 },
+    {   8835, "NotSuperset", 8402 },
+    {   8841, "NotSupersetEqual", 0 },
+    {   8769, "NotTilde", 0 },
+    {   8772, "NotTildeEqual", 0 },
+    {   8775, "NotTildeFullEqual", 0 },
+    {   8777, "NotTildeTilde", 0 },
+    {   8740, "NotVerticalBar", 0 },
+    { 119977, "Nscr", 0 },
+    {    209, "Ntilde", 0 },
+    {    925, "Nu", 0 },
+    {    338, "OElig", 0 },
+    {    211, "Oacute", 0 },
+    {    212, "Ocirc", 0 },
+    {   1054, "Ocy", 0 },
+    {    336, "Odblac", 0 },
+    { 120082, "Ofr", 0 },
+    {    210, "Ograve", 0 },
+    {    332, "Omacr", 0 },
+    {    937, "Omega", 0 },
+    {    927, "Omicron", 0 },
+    { 120134, "Oopf", 0 },
+    {   8220, "OpenCurlyDoubleQuote", 0 },
+    {   8216, "OpenCurlyQuote", 0 },
+    {  10836, "Or", 0 },
+    { 119978, "Oscr", 0 },
+    {    216, "Oslash", 0 },
+    {    213, "Otilde", 0 },
+    {  10807, "Otimes", 0 },
+    {    214, "Ouml", 0 },
+    {   8254, "OverBar", 0 },
+    {   9182, "OverBrace", 0 },
+    {   9140, "OverBracket", 0 },
+    {   9180, "OverParenthesis", 0 },
+    {   8706, "PartialD", 0 },
+    {   1055, "Pcy", 0 },
+    { 120083, "Pfr", 0 },
+    {    934, "Phi", 0 },
+    {    928, "Pi", 0 },
+    {    177, "PlusMinus", 0 },
+    {   8460, "Poincareplane", 0 },
+    {   8473, "Popf", 0 },
+    {  10939, "Pr", 0 },
+    {   8826, "Precedes", 0 },
+    {  10927, "PrecedesEqual", 0 },
+    {   8828, "PrecedesSlantEqual", 0 },
+    {   8830, "PrecedesTilde", 0 },
+    {   8243, "Prime", 0 },
+    {   8719, "Product", 0 },
+    {   8759, "Proportion", 0 },
+    {   8733, "Proportional", 0 },
+    { 119979, "Pscr", 0 },
+    {    936, "Psi", 0 },
+    {     34, "QUOT", 0 },
+    { 120084, "Qfr", 0 },
+    {   8474, "Qopf", 0 },
+    { 119980, "Qscr", 0 },
+    {  10512, "RBarr", 0 },
+    {    174, "REG", 0 },
+    {    340, "Racute", 0 },
+    {  10219, "Rang", 0 },
+    {   8608, "Rarr", 0 },
+    {  10518, "Rarrtl", 0 },
+    {    344, "Rcaron", 0 },
+    {    342, "Rcedil", 0 },
+    {   1056, "Rcy", 0 },
+    {   8476, "Re", 0 },
+    {   8715, "ReverseElement", 0 },
+    {   8651, "ReverseEquilibrium", 0 },
+    {  10607, "ReverseUpEquilibrium", 0 },
+    {   8476, "Rfr", 0 },
+    {    929, "Rho", 0 },
+    {  10217, "RightAngleBracket", 0 },
+    {   8594, "RightArrow", 0 },
+    {   8677, "RightArrowBar", 0 },
+    {   8644, "RightArrowLeftArrow", 0 },
+    {   8969, "RightCeiling", 0 },
+    {  10215, "RightDoubleBracket", 0 },
+    {  10589, "RightDownTeeVector", 0 },
+    {   8642, "RightDownVector", 0 },
+    {  10581, "RightDownVectorBar", 0 },
+    {   8971, "RightFloor", 0 },
+    {   8866, "RightTee", 0 },
+    {   8614, "RightTeeArrow", 0 },
+    {  10587, "RightTeeVector", 0 },
+    {   8883, "RightTriangle", 0 },
+    {  10704, "RightTriangleBar", 0 },
+    {   8885, "RightTriangleEqual", 0 },
+    {  10575, "RightUpDownVector", 0 },
+    {  10588, "RightUpTeeVector", 0 },
+    {   8638, "RightUpVector", 0 },
+    {  10580, "RightUpVectorBar", 0 },
+    {   8640, "RightVector", 0 },
+    {  10579, "RightVectorBar", 0 },
+    {   8658, "Rightarrow", 0 },
+    {   8477, "Ropf", 0 },
+    {  10608, "RoundImplies", 0 },
+    {   8667, "Rrightarrow", 0 },
+    {   8475, "Rscr", 0 },
+    {   8625, "Rsh", 0 },
+    {  10740, "RuleDelayed", 0 },
+    {   1065, "SHCHcy", 0 },
+    {   1064, "SHcy", 0 },
+    {   1068, "SOFTcy", 0 },
+    {    346, "Sacute", 0 },
+    {  10940, "Sc", 0 },
+    {    352, "Scaron", 0 },
+    {    350, "Scedil", 0 },
+    {    348, "Scirc", 0 },
+    {   1057, "Scy", 0 },
+    { 120086, "Sfr", 0 },
+    {   8595, "ShortDownArrow", 0 },
+    {   8592, "ShortLeftArrow", 0 },
+    {   8594, "ShortRightArrow", 0 },
+    {   8593, "ShortUpArrow", 0 },
+    {    931, "Sigma", 0 },
+    {   8728, "SmallCircle", 0 },
+    { 120138, "Sopf", 0 },
+    {   8730, "Sqrt", 0 },
+    {   9633, "Square", 0 },
+    {   8851, "SquareIntersection", 0 },
+    {   8847, "SquareSubset", 0 },
+    {   8849, "SquareSubsetEqual", 0 },
+    {   8848, "SquareSuperset", 0 },
+    {   8850, "SquareSupersetEqual", 0 },
+    {   8852, "SquareUnion", 0 },
+    { 119982, "Sscr", 0 },
+    {   8902, "Star", 0 },
+    {   8912, "Sub", 0 },
+    {   8912, "Subset", 0 },
+    {   8838, "SubsetEqual", 0 },
+    {   8827, "Succeeds", 0 },
+    {  10928, "SucceedsEqual", 0 },
+    {   8829, "SucceedsSlantEqual", 0 },
+    {   8831, "SucceedsTilde", 0 },
+    {   8715, "SuchThat", 0 },
+    {   8721, "Sum", 0 },
+    {   8913, "Sup", 0 },
+    {   8835, "Superset", 0 },
+    {   8839, "SupersetEqual", 0 },
+    {   8913, "Supset", 0 },
+    {    222, "THORN", 0 },
+    {   8482, "TRADE", 0 },
+    {   1035, "TSHcy", 0 },
+    {   1062, "TScy", 0 },
+    {      9, "Tab", 0 },
+    {    932, "Tau", 0 },
+    {    356, "Tcaron", 0 },
+    {    354, "Tcedil", 0 },
+    {   1058, "Tcy", 0 },
+    { 120087, "Tfr", 0 },
+    {   8756, "Therefore", 0 },
+    {    920, "Theta", 0 },
+    {   8287, "ThickSpace", 8202 },
+    {   8201, "ThinSpace", 0 },
+    {   8764, "Tilde", 0 },
+    {   8771, "TildeEqual", 0 },
+    {   8773, "TildeFullEqual", 0 },
+    {   8776, "TildeTilde", 0 },
+    { 120139, "Topf", 0 },
+    {   8411, "TripleDot", 0 },
+    { 119983, "Tscr", 0 },
+    {    358, "Tstrok", 0 },
+    {    218, "Uacute", 0 },
+    {   8607, "Uarr", 0 },
+    {  10569, "Uarrocir", 0 },
+    {   1038, "Ubrcy", 0 },
+    {    364, "Ubreve", 0 },
+    {    219, "Ucirc", 0 },
+    {   1059, "Ucy", 0 },
+    {    368, "Udblac", 0 },
+    { 120088, "Ufr", 0 },
+    {    217, "Ugrave", 0 },
+    {    362, "Umacr", 0 },
+    {     95, "UnderBar", 0 },
+    {   9183, "UnderBrace", 0 },
+    {   9141, "UnderBracket", 0 },
+    {   9181, "UnderParenthesis", 0 },
+    {   8899, "Union", 0 },
+    {   8846, "UnionPlus", 0 },
+    {    370, "Uogon", 0 },
+    { 120140, "Uopf", 0 },
+    {   8593, "UpArrow", 0 },
+    {  10514, "UpArrowBar", 0 },
+    {   8645, "UpArrowDownArrow", 0 },
+    {   8597, "UpDownArrow", 0 },
+    {  10606, "UpEquilibrium", 0 },
+    {   8869, "UpTee", 0 },
+    {   8613, "UpTeeArrow", 0 },
+    {   8657, "Uparrow", 0 },
+    {   8661, "Updownarrow", 0 },
+    {   8598, "UpperLeftArrow", 0 },
+    {   8599, "UpperRightArrow", 0 },
+    {    978, "Upsi", 0 },
+    {    933, "Upsilon", 0 },
+    {    366, "Uring", 0 },
+    { 119984, "Uscr", 0 },
+    {    360, "Utilde", 0 },
+    {    220, "Uuml", 0 },
+    {   8875, "VDash", 0 },
+    {  10987, "Vbar", 0 },
+    {   1042, "Vcy", 0 },
+    {   8873, "Vdash", 0 },
+    {  10982, "Vdashl", 0 },
+    {   8897, "Vee", 0 },
+    {   8214, "Verbar", 0 },
+    {   8214, "Vert", 0 },
+    {   8739, "VerticalBar", 0 },
+    {    124, "VerticalLine", 0 },
+    {  10072, "VerticalSeparator", 0 },
+    {   8768, "VerticalTilde", 0 },
+    {   8202, "VeryThinSpace", 0 },
+    { 120089, "Vfr", 0 },
+    { 120141, "Vopf", 0 },
+    { 119985, "Vscr", 0 },
+    {   8874, "Vvdash", 0 },
+    {    372, "Wcirc", 0 },
+    {   8896, "Wedge", 0 },
+    { 120090, "Wfr", 0 },
+    { 120142, "Wopf", 0 },
+    { 119986, "Wscr", 0 },
+    { 120091, "Xfr", 0 },
+    {    926, "Xi", 0 },
+    { 120143, "Xopf", 0 },
+    { 119987, "Xscr", 0 },
+    {   1071, "YAcy", 0 },
+    {   1031, "YIcy", 0 },
+    {   1070, "YUcy", 0 },
+    {    221, "Yacute", 0 },
+    {    374, "Ycirc", 0 },
+    {   1067, "Ycy", 0 },
+    { 120092, "Yfr", 0 },
+    { 120144, "Yopf", 0 },
+    { 119988, "Yscr", 0 },
+    {    376, "Yuml", 0 },
+    {   1046, "ZHcy", 0 },
+    {    377, "Zacute", 0 },
+    {    381, "Zcaron", 0 },
+    {   1047, "Zcy", 0 },
+    {    379, "Zdot", 0 },
+    {   8203, "ZeroWidthSpace", 0 },
+    {    918, "Zeta", 0 },
+    {   8488, "Zfr", 0 },
+    {   8484, "Zopf", 0 },
+    { 119989, "Zscr", 0 },
+    {    225, "aacute", 0 },
+    {    259, "abreve", 0 },
+    {   8766, "ac", 0 },
+    {   8766, "acE", 819 },
+    {   8767, "acd", 0 },
+    {    226, "acirc", 0 },
+    {    180, "acute", 0 },
+    {   1072, "acy", 0 },
+    {    230, "aelig", 0 },
+    {   8289, "af", 0 },
+    { 120094, "afr", 0 },
+    {    224, "agrave", 0 },
+    {   8501, "alefsym", 0 },
+    {   8501, "aleph", 0 },
+    {    945, "alpha", 0 },
+    {    257, "amacr", 0 },
+    {  10815, "amalg", 0 },
+    {     38, "amp", 0 },
+    {   8743, "and", 0 },
+    {  10837, "andand", 0 },
+    {  10844, "andd", 0 },
+    {  10840, "andslope", 0 },
+    {  10842, "andv", 0 },
+    {   8736, "ang", 0 },
+    {  10660, "ange", 0 },
+    {   8736, "angle", 0 },
+    {   8737, "angmsd", 0 },
+    {  10664, "angmsdaa", 0 },
+    {  10665, "angmsdab", 0 },
+    {  10666, "angmsdac", 0 },
+    {  10667, "angmsdad", 0 },
+    {  10668, "angmsdae", 0 },
+    {  10669, "angmsdaf", 0 },
+    {  10670, "angmsdag", 0 },
+    {  10671, "angmsdah", 0 },
+    {   8735, "angrt", 0 },
+    {   8894, "angrtvb", 0 },
+    {  10653, "angrtvbd", 0 },
+    {   8738, "angsph", 0 },
+    {    197, "angst", 0 },
+    {   9084, "angzarr", 0 },
+    {    261, "aogon", 0 },
+    { 120146, "aopf", 0 },
+    {   8776, "ap", 0 },
+    {  10864, "apE", 0 },
+    {  10863, "apacir", 0 },
+    {   8778, "ape", 0 },
+    {   8779, "apid", 0 },
+    {     39, "apos", 0 },
+    {   8776, "approx", 0 },
+    {   8778, "approxeq", 0 },
+    {    229, "aring", 0 },
+    { 119990, "ascr", 0 },
+    {     42, "ast", 0 },
+    {   8776, "asymp", 0 },
+    {   8781, "asympeq", 0 },
+    {    227, "atilde", 0 },
+    {    228, "auml", 0 },
+    {   8755, "awconint", 0 },
+    {  10769, "awint", 0 },
+    {  10989, "bNot", 0 },
+    {   8780, "backcong", 0 },
+    {   1014, "backepsilon", 0 },
+    {   8245, "backprime", 0 },
+    {   8765, "backsim", 0 },
+    {   8909, "backsimeq", 0 },
+    {   8893, "barvee", 0 },
+    {   8965, "barwed", 0 },
+    {   8965, "barwedge", 0 },
+    {   9141, "bbrk", 0 },
+    {   9142, "bbrktbrk", 0 },
+    {   8780, "bcong", 0 },
+    {   1073, "bcy", 0 },
+    {   8222, "bdquo", 0 },
+    {   8757, "becaus", 0 },
+    {   8757, "because", 0 },
+    {  10672, "bemptyv", 0 },
+    {   1014, "bepsi", 0 },
+    {   8492, "bernou", 0 },
+    {    946, "beta", 0 },
+    {   8502, "beth", 0 },
+    {   8812, "between", 0 },
+    { 120095, "bfr", 0 },
+    {   8898, "bigcap", 0 },
+    {   9711, "bigcirc", 0 },
+    {   8899, "bigcup", 0 },
+    {  10752, "bigodot", 0 },
+    {  10753, "bigoplus", 0 },
+    {  10754, "bigotimes", 0 },
+    {  10758, "bigsqcup", 0 },
+    {   9733, "bigstar", 0 },
+    {   9661, "bigtriangledown", 0 },
+    {   9651, "bigtriangleup", 0 },
+    {  10756, "biguplus", 0 },
+    {   8897, "bigvee", 0 },
+    {   8896, "bigwedge", 0 },
+    {  10509, "bkarow", 0 },
+    {  10731, "blacklozenge", 0 },
+    {   9642, "blacksquare", 0 },
+    {   9652, "blacktriangle", 0 },
+    {   9662, "blacktriangledown", 0 },
+    {   9666, "blacktriangleleft", 0 },
+    {   9656, "blacktriangleright", 0 },
+    {   9251, "blank", 0 },
+    {   9618, "blk12", 0 },
+    {   9617, "blk14", 0 },
+    {   9619, "blk34", 0 },
+    {   9608, "block", 0 },
+    {     61, "bne", 8421 },
+    {   8801, "bnequiv", 8421 },
+    {   8976, "bnot", 0 },
+    { 120147, "bopf", 0 },
+    {   8869, "bot", 0 },
+    {   8869, "bottom", 0 },
+    {   8904, "bowtie", 0 },
+    {   9559, "boxDL", 0 },
+    {   9556, "boxDR", 0 },
+    {   9558, "boxDl", 0 },
+    {   9555, "boxDr", 0 },
+    {   9552, "boxH", 0 },
+    {   9574, "boxHD", 0 },
+    {   9577, "boxHU", 0 },
+    {   9572, "boxHd", 0 },
+    {   9575, "boxHu", 0 },
+    {   9565, "boxUL", 0 },
+    {   9562, "boxUR", 0 },
+    {   9564, "boxUl", 0 },
+    {   9561, "boxUr", 0 },
+    {   9553, "boxV", 0 },
+    {   9580, "boxVH", 0 },
+    {   9571, "boxVL", 0 },
+    {   9568, "boxVR", 0 },
+    {   9579, "boxVh", 0 },
+    {   9570, "boxVl", 0 },
+    {   9567, "boxVr", 0 },
+    {  10697, "boxbox", 0 },
+    {   9557, "boxdL", 0 },
+    {   9554, "boxdR", 0 },
+    {   9488, "boxdl", 0 },
+    {   9484, "boxdr", 0 },
+    {   9472, "boxh", 0 },
+    {   9573, "boxhD", 0 },
+    {   9576, "boxhU", 0 },
+    {   9516, "boxhd", 0 },
+    {   9524, "boxhu", 0 },
+    {   8863, "boxminus", 0 },
+    {   8862, "boxplus", 0 },
+    {   8864, "boxtimes", 0 },
+    {   9563, "boxuL", 0 },
+    {   9560, "boxuR", 0 },
+    {   9496, "boxul", 0 },
+    {   9492, "boxur", 0 },
+    {   9474, "boxv", 0 },
+    {   9578, "boxvH", 0 },
+    {   9569, "boxvL", 0 },
+    {   9566, "boxvR", 0 },
+    {   9532, "boxvh", 0 },
+    {   9508, "boxvl", 0 },
+    {   9500, "boxvr", 0 },
+    {   8245, "bprime", 0 },
+    {    728, "breve", 0 },
+    {    166, "brvbar", 0 },
+    { 119991, "bscr", 0 },
+    {   8271, "bsemi", 0 },
+    {   8765, "bsim", 0 },
+    {   8909, "bsime", 0 },
+    {     92, "bsol", 0 },
+    {  10693, "bsolb", 0 },
+    {  10184, "bsolhsub", 0 },
+    {   8226, "bull", 0 },
+    {   8226, "bullet", 0 },
+    {   8782, "bump", 0 },
+    {  10926, "bumpE", 0 },
+    {   8783, "bumpe", 0 },
+    {   8783, "bumpeq", 0 },
+    {    263, "cacute", 0 },
+    {   8745, "cap", 0 },
+    {  10820, "capand", 0 },
+    {  10825, "capbrcup", 0 },
+    {  10827, "capcap", 0 },
+    {  10823, "capcup", 0 },
+    {  10816, "capdot", 0 },
+    {   8745, "caps", 65024 },
+    {   8257, "caret", 0 },
+    {    711, "caron", 0 },
+    {  10829, "ccaps", 0 },
+    {    269, "ccaron", 0 },
+    {    231, "ccedil", 0 },
+    {    265, "ccirc", 0 },
+    {  10828, "ccups", 0 },
+    {  10832, "ccupssm", 0 },
+    {    267, "cdot", 0 },
+    {    184, "cedil", 0 },
+    {  10674, "cemptyv", 0 },
+    {    162, "cent", 0 },
+    {    183, "centerdot", 0 },
+    { 120096, "cfr", 0 },
+    {   1095, "chcy", 0 },
+    {  10003, "check", 0 },
+    {  10003, "checkmark", 0 },
+    {    967, "chi", 0 },
+    {   9675, "cir", 0 },
+    {  10691, "cirE", 0 },
+    {    710, "circ", 0 },
+    {   8791, "circeq", 0 },
+    {   8634, "circlearrowleft", 0 },
+    {   8635, "circlearrowright", 0 },
+    {    174, "circledR", 0 },
+    {   9416, "circledS", 0 },
+    {   8859, "circledast", 0 },
+    {   8858, "circledcirc", 0 },
+    {   8861, "circleddash", 0 },
+    {   8791, "cire", 0 },
+    {  10768, "cirfnint", 0 },
+    {  10991, "cirmid", 0 },
+    {  10690, "cirscir", 0 },
+    {   9827, "clubs", 0 },
+    {   9827, "clubsuit", 0 },
+    {     58, "colon", 0 },
+    {   8788, "colone", 0 },
+    {   8788, "coloneq", 0 },
+    {     44, "comma", 0 },
+    {     64, "commat", 0 },
+    {   8705, "comp", 0 },
+    {   8728, "compfn", 0 },
+    {   8705, "complement", 0 },
+    {   8450, "complexes", 0 },
+    {   8773, "cong", 0 },
+    {  10861, "congdot", 0 },
+    {   8750, "conint", 0 },
+    { 120148, "copf", 0 },
+    {   8720, "coprod", 0 },
+    {    169, "copy", 0 },
+    {   8471, "copysr", 0 },
+    {   8629, "crarr", 0 },
+    {  10007, "cross", 0 },
+    { 119992, "cscr", 0 },
+    {  10959, "csub", 0 },
+    {  10961, "csube", 0 },
+    {  10960, "csup", 0 },
+    {  10962, "csupe", 0 },
+    {   8943, "ctdot", 0 },
+    {  10552, "cudarrl", 0 },
+    {  10549, "cudarrr", 0 },
+    {   8926, "cuepr", 0 },
+    {   8927, "cuesc", 0 },
+    {   8630, "cularr", 0 },
+    {  10557, "cularrp", 0 },
+    {   8746, "cup", 0 },
+    {  10824, "cupbrcap", 0 },
+    {  10822, "cupcap", 0 },
+    {  10826, "cupcup", 0 },
+    {   8845, "cupdot", 0 },
+    {  10821, "cupor", 0 },
+    {   8746, "cups", 65024 },
+    {   8631, "curarr", 0 },
+    {  10556, "curarrm", 0 },
+    {   8926, "curlyeqprec", 0 },
+    {   8927, "curlyeqsucc", 0 },
+    {   8910, "curlyvee", 0 },
+    {   8911, "curlywedge", 0 },
+    {    164, "curren", 0 },
+    {   8630, "curvearrowleft", 0 },
+    {   8631, "curvearrowright", 0 },
+    {   8910, "cuvee", 0 },
+    {   8911, "cuwed", 0 },
+    {   8754, "cwconint", 0 },
+    {   8753, "cwint", 0 },
+    {   9005, "cylcty", 0 },
+    {   8659, "dArr", 0 },
+    {  10597, "dHar", 0 },
+    {   8224, "dagger", 0 },
+    {   8504, "daleth", 0 },
+    {   8595, "darr", 0 },
+    {   8208, "dash", 0 },
+    {   8867, "dashv", 0 },
+    {  10511, "dbkarow", 0 },
+    {    733, "dblac", 0 },
+    {    271, "dcaron", 0 },
+    {   1076, "dcy", 0 },
+    {   8518, "dd", 0 },
+    {   8225, "ddagger", 0 },
+    {   8650, "ddarr", 0 },
+    {  10871, "ddotseq", 0 },
+    {    176, "deg", 0 },
+    {    948, "delta", 0 },
+    {  10673, "demptyv", 0 },
+    {  10623, "dfisht", 0 },
+    { 120097, "dfr", 0 },
+    {   8643, "dharl", 0 },
+    {   8642, "dharr", 0 },
+    {   8900, "diam", 0 },
+    {   8900, "diamond", 0 },
+    {   9830, "diamondsuit", 0 },
+    {   9830, "diams", 0 },
+    {    168, "die", 0 },
+    {    989, "digamma", 0 },
+    {   8946, "disin", 0 },
+    {    247, "div", 0 },
+    {    247, "divide", 0 },
+    {   8903, "divideontimes", 0 },
+    {   8903, "divonx", 0 },
+    {   1106, "djcy", 0 },
+    {   8990, "dlcorn", 0 },
+    {   8973, "dlcrop", 0 },
+    {     36, "dollar", 0 },
+    { 120149, "dopf", 0 },
+    {    729, "dot", 0 },
+    {   8784, "doteq", 0 },
+    {   8785, "doteqdot", 0 },
+    {   8760, "dotminus", 0 },
+    {   8724, "dotplus", 0 },
+    {   8865, "dotsquare", 0 },
+    {   8966, "doublebarwedge", 0 },
+    {   8595, "downarrow", 0 },
+    {   8650, "downdownarrows", 0 },
+    {   8643, "downharpoonleft", 0 },
+    {   8642, "downharpoonright", 0 },
+    {  10512, "drbkarow", 0 },
+    {   8991, "drcorn", 0 },
+    {   8972, "drcrop", 0 },
+    { 119993, "dscr", 0 },
+    {   1109, "dscy", 0 },
+    {  10742, "dsol", 0 },
+    {    273, "dstrok", 0 },
+    {   8945, "dtdot", 0 },
+    {   9663, "dtri", 0 },
+    {   9662, "dtrif", 0 },
+    {   8693, "duarr", 0 },
+    {  10607, "duhar", 0 },
+    {  10662, "dwangle", 0 },
+    {   1119, "dzcy", 0 },
+    {  10239, "dzigrarr", 0 },
+    {  10871, "eDDot", 0 },
+    {   8785, "eDot", 0 },
+    {    233, "eacute", 0 },
+    {  10862, "easter", 0 },
+    {    283, "ecaron", 0 },
+    {   8790, "ecir", 0 },
+    {    234, "ecirc", 0 },
+    {   8789, "ecolon", 0 },
+    {   1101, "ecy", 0 },
+    {    279, "edot", 0 },
+    {   8519, "ee", 0 },
+    {   8786, "efDot", 0 },
+    { 120098, "efr", 0 },
+    {  10906, "eg", 0 },
+    {    232, "egrave", 0 },
+    {  10902, "egs", 0 },
+    {  10904, "egsdot", 0 },
+    {  10905, "el", 0 },
+    {   9191, "elinters", 0 },
+    {   8467, "ell", 0 },
+    {  10901, "els", 0 },
+    {  10903, "elsdot", 0 },
+    {    275, "emacr", 0 },
+    {   8709, "empty", 0 },
+    {   8709, "emptyset", 0 },
+    {   8709, "emptyv", 0 },
+    {   8195, "emsp", 0 },
+    {   8196, "emsp13", 0 },
+    {   8197, "emsp14", 0 },
+    {    331, "eng", 0 },
+    {   8194, "ensp", 0 },
+    {    281, "eogon", 0 },
+    { 120150, "eopf", 0 },
+    {   8917, "epar", 0 },
+    {  10723, "eparsl", 0 },
+    {  10865, "eplus", 0 },
+    {    949, "epsi", 0 },
+    {    949, "epsilon", 0 },
+    {   1013, "epsiv", 0 },
+    {   8790, "eqcirc", 0 },
+    {   8789, "eqcolon", 0 },
+    {   8770, "eqsim", 0 },
+    {  10902, "eqslantgtr", 0 },
+    {  10901, "eqslantless", 0 },
+    {     61, "equals", 0 },
+    {   8799, "equest", 0 },
+    {   8801, "equiv", 0 },
+    {  10872, "equivDD", 0 },
+    {  10725, "eqvparsl", 0 },
+    {   8787, "erDot", 0 },
+    {  10609, "erarr", 0 },
+    {   8495, "escr", 0 },
+    {   8784, "esdot", 0 },
+    {   8770, "esim", 0 },
+    {    951, "eta", 0 },
+    {    240, "eth", 0 },
+    {    235, "euml", 0 },
+    {   8364, "euro", 0 },
+    {     33, "excl", 0 },
+    {   8707, "exist", 0 },
+    {   8496, "expectation", 0 },
+    {   8519, "exponentiale", 0 },
+    {   8786, "fallingdotseq", 0 },
+    {   1092, "fcy", 0 },
+    {   9792, "female", 0 },
+    {  64259, "ffilig", 0 },
+    {  64256, "fflig", 0 },
+    {  64260, "ffllig", 0 },
+    { 120099, "ffr", 0 },
+    {  64257, "filig", 0 },
+    {    102, "fjlig", 106 },
+    {   9837, "flat", 0 },
+    {  64258, "fllig", 0 },
+    {   9649, "fltns", 0 },
+    {    402, "fnof", 0 },
+    { 120151, "fopf", 0 },
+    {   8704, "forall", 0 },
+    {   8916, "fork", 0 },
+    {  10969, "forkv", 0 },
+    {  10765, "fpartint", 0 },
+    {    189, "frac12", 0 },
+    {   8531, "frac13", 0 },
+    {    188, "frac14", 0 },
+    {   8533, "frac15", 0 },
+    {   8537, "frac16", 0 },
+    {   8539, "frac18", 0 },
+    {   8532, "frac23", 0 },
+    {   8534, "frac25", 0 },
+    {    190, "frac34", 0 },
+    {   8535, "frac35", 0 },
+    {   8540, "frac38", 0 },
+    {   8536, "frac45", 0 },
+    {   8538, "frac56", 0 },
+    {   8541, "frac58", 0 },
+    {   8542, "frac78", 0 },
+    {   8260, "frasl", 0 },
+    {   8994, "frown", 0 },
+    { 119995, "fscr", 0 },
+    {   8807, "gE", 0 },
+    {  10892, "gEl", 0 },
+    {    501, "gacute", 0 },
+    {    947, "gamma", 0 },
+    {    989, "gammad", 0 },
+    {  10886, "gap", 0 },
+    {    287, "gbreve", 0 },
+    {    285, "gcirc", 0 },
+    {   1075, "gcy", 0 },
+    {    289, "gdot", 0 },
+    {   8805, "ge", 0 },
+    {   8923, "gel", 0 },
+    {   8805, "geq", 0 },
+    {   8807, "geqq", 0 },
+    {  10878, "geqslant", 0 },
+    {  10878, "ges", 0 },
+    {  10921, "gescc", 0 },
+    {  10880, "gesdot", 0 },
+    {  10882, "gesdoto", 0 },
+    {  10884, "gesdotol", 0 },
+    {   8923, "gesl", 65024 },
+    {  10900, "gesles", 0 },
+    { 120100, "gfr", 0 },
+    {   8811, "gg", 0 },
+    {   8921, "ggg", 0 },
+    {   8503, "gimel", 0 },
+    {   1107, "gjcy", 0 },
+    {   8823, "gl", 0 },
+    {  10898, "glE", 0 },
+    {  10917, "gla", 0 },
+    {  10916, "glj", 0 },
+    {   8809, "gnE", 0 },
+    {  10890, "gnap", 0 },
+    {  10890, "gnapprox", 0 },
+    {  10888, "gne", 0 },
+    {  10888, "gneq", 0 },
+    {   8809, "gneqq", 0 },
+    {   8935, "gnsim", 0 },
+    { 120152, "gopf", 0 },
+    {     96, "grave", 0 },
+    {   8458, "gscr", 0 },
+    {   8819, "gsim", 0 },
+    {  10894, "gsime", 0 },
+    {  10896, "gsiml", 0 },
+    {     62, "gt", 0 },
+    {  10919, "gtcc", 0 },
+    {  10874, "gtcir", 0 },
+    {   8919, "gtdot", 0 },
+    {  10645, "gtlPar", 0 },
+    {  10876, "gtquest", 0 },
+    {  10886, "gtrapprox", 0 },
+    {  10616, "gtrarr", 0 },
+    {   8919, "gtrdot", 0 },
+    {   8923, "gtreqless", 0 },
+    {  10892, "gtreqqless", 0 },
+    {   8823, "gtrless", 0 },
+    {   8819, "gtrsim", 0 },
+    {   8809, "gvertneqq", 65024 },
+    {   8809, "gvnE", 65024 },
+    {   8660, "hArr", 0 },
+    {   8202, "hairsp", 0 },
+    {    189, "half", 0 },
+    {   8459, "hamilt", 0 },
+    {   1098, "hardcy", 0 },
+    {   8596, "harr", 0 },
+    {  10568, "harrcir", 0 },
+    {   8621, "harrw", 0 },
+    {   8463, "hbar", 0 },
+    {    293, "hcirc", 0 },
+    {   9829, "hearts", 0 },
+    {   9829, "heartsuit", 0 },
+    {   8230, "hellip", 0 },
+    {   8889, "hercon", 0 },
+    { 120101, "hfr", 0 },
+    {  10533, "hksearow", 0 },
+    {  10534, "hkswarow", 0 },
+    {   8703, "hoarr", 0 },
+    {   8763, "homtht", 0 },
+    {   8617, "hookleftarrow", 0 },
+    {   8618, "hookrightarrow", 0 },
+    { 120153, "hopf", 0 },
+    {   8213, "horbar", 0 },
+    { 119997, "hscr", 0 },
+    {   8463, "hslash", 0 },
+    {    295, "hstrok", 0 },
+    {   8259, "hybull", 0 },
+    {   8208, "hyphen", 0 },
+    {    237, "iacute", 0 },
+    {   8291, "ic", 0 },
+    {    238, "icirc", 0 },
+    {   1080, "icy", 0 },
+    {   1077, "iecy", 0 },
+    {    161, "iexcl", 0 },
+    {   8660, "iff", 0 },
+    { 120102, "ifr", 0 },
+    {    236, "igrave", 0 },
+    {   8520, "ii", 0 },
+    {  10764, "iiiint", 0 },
+    {   8749, "iiint", 0 },
+    {  10716, "iinfin", 0 },
+    {   8489, "iiota", 0 },
+    {    307, "ijlig", 0 },
+    {    299, "imacr", 0 },
+    {   8465, "image", 0 },
+    {   8464, "imagline", 0 },
+    {   8465, "imagpart", 0 },
+    {    305, "imath", 0 },
+    {   8887, "imof", 0 },
+    {    437, "imped", 0 },
+    {   8712, "in", 0 },
+    {   8453, "incare", 0 },
+    {   8734, "infin", 0 },
+    {  10717, "infintie", 0 },
+    {    305, "inodot", 0 },
+    {   8747, "int", 0 },
+    {   8890, "intcal", 0 },
+    {   8484, "integers", 0 },
+    {   8890, "intercal", 0 },
+    {  10775, "intlarhk", 0 },
+    {  10812, "intprod", 0 },
+    {   1105, "iocy", 0 },
+    {    303, "iogon", 0 },
+    { 120154, "iopf", 0 },
+    {    953, "iota", 0 },
+    {  10812, "iprod", 0 },
+    {    191, "iquest", 0 },
+    { 119998, "iscr", 0 },
+    {   8712, "isin", 0 },
+    {   8953, "isinE", 0 },
+    {   8949, "isindot", 0 },
+    {   8948, "isins", 0 },
+    {   8947, "isinsv", 0 },
+    {   8712, "isinv", 0 },
+    {   8290, "it", 0 },
+    {    297, "itilde", 0 },
+    {   1110, "iukcy", 0 },
+    {    239, "iuml", 0 },
+    {    309, "jcirc", 0 },
+    {   1081, "jcy", 0 },
+    { 120103, "jfr", 0 },
+    {    567, "jmath", 0 },
+    { 120155, "jopf", 0 },
+    { 119999, "jscr", 0 },
+    {   1112, "jsercy", 0 },
+    {   1108, "jukcy", 0 },
+    {    954, "kappa", 0 },
+    {   1008, "kappav", 0 },
+    {    311, "kcedil", 0 },
+    {   1082, "kcy", 0 },
+    { 120104, "kfr", 0 },
+    {    312, "kgreen", 0 },
+    {   1093, "khcy", 0 },
+    {   1116, "kjcy", 0 },
+    { 120156, "kopf", 0 },
+    { 120000, "kscr", 0 },
+    {   8666, "lAarr", 0 },
+    {   8656, "lArr", 0 },
+    {  10523, "lAtail", 0 },
+    {  10510, "lBarr", 0 },
+    {   8806, "lE", 0 },
+    {  10891, "lEg", 0 },
+    {  10594, "lHar", 0 },
+    {    314, "lacute", 0 },
+    {  10676, "laemptyv", 0 },
+    {   8466, "lagran", 0 },
+    {    955, "lambda", 0 },
+    {  10216, "lang", 0 },
+    {  10641, "langd", 0 },
+    {  10216, "langle", 0 },
+    {  10885, "lap", 0 },
+    {    171, "laquo", 0 },
+    {   8592, "larr", 0 },
+    {   8676, "larrb", 0 },
+    {  10527, "larrbfs", 0 },
+    {  10525, "larrfs", 0 },
+    {   8617, "larrhk", 0 },
+    {   8619, "larrlp", 0 },
+    {  10553, "larrpl", 0 },
+    {  10611, "larrsim", 0 },
+    {   8610, "larrtl", 0 },
+    {  10923, "lat", 0 },
+    {  10521, "latail", 0 },
+    {  10925, "late", 0 },
+    {  10925, "lates", 65024 },
+    {  10508, "lbarr", 0 },
+    {  10098, "lbbrk", 0 },
+    {    123, "lbrace", 0 },
+    {     91, "lbrack", 0 },
+    {  10635, "lbrke", 0 },
+    {  10639, "lbrksld", 0 },
+    {  10637, "lbrkslu", 0 },
+    {    318, "lcaron", 0 },
+    {    316, "lcedil", 0 },
+    {   8968, "lceil", 0 },
+    {    123, "lcub", 0 },
+    {   1083, "lcy", 0 },
+    {  10550, "ldca", 0 },
+    {   8220, "ldquo", 0 },
+    {   8222, "ldquor", 0 },
+    {  10599, "ldrdhar", 0 },
+    {  10571, "ldrushar", 0 },
+    {   8626, "ldsh", 0 },
+    {   8804, "le", 0 },
+    {   8592, "leftarrow", 0 },
+    {   8610, "leftarrowtail", 0 },
+    {   8637, "leftharpoondown", 0 },
+    {   8636, "leftharpoonup", 0 },
+    {   8647, "leftleftarrows", 0 },
+    {   8596, "leftrightarrow", 0 },
+    {   8646, "leftrightarrows", 0 },
+    {   8651, "leftrightharpoons", 0 },
+    {   8621, "leftrightsquigarrow", 0 },
+    {   8907, "leftthreetimes", 0 },
+    {   8922, "leg", 0 },
+    {   8804, "leq", 0 },
+    {   8806, "leqq", 0 },
+    {  10877, "leqslant", 0 },
+    {  10877, "les", 0 },
+    {  10920, "lescc", 0 },
+    {  10879, "lesdot", 0 },
+    {  10881, "lesdoto", 0 },
+    {  10883, "lesdotor", 0 },
+    {   8922, "lesg", 65024 },
+    {  10899, "lesges", 0 },
+    {  10885, "lessapprox", 0 },
+    {   8918, "lessdot", 0 },
+    {   8922, "lesseqgtr", 0 },
+    {  10891, "lesseqqgtr", 0 },
+    {   8822, "lessgtr", 0 },
+    {   8818, "lesssim", 0 },
+    {  10620, "lfisht", 0 },
+    {   8970, "lfloor", 0 },
+    { 120105, "lfr", 0 },
+    {   8822, "lg", 0 },
+    {  10897, "lgE", 0 },
+    {   8637, "lhard", 0 },
+    {   8636, "lharu", 0 },
+    {  10602, "lharul", 0 },
+    {   9604, "lhblk", 0 },
+    {   1113, "ljcy", 0 },
+    {   8810, "ll", 0 },
+    {   8647, "llarr", 0 },
+    {   8990, "llcorner", 0 },
+    {  10603, "llhard", 0 },
+    {   9722, "lltri", 0 },
+    {    320, "lmidot", 0 },
+    {   9136, "lmoust", 0 },
+    {   9136, "lmoustache", 0 },
+    {   8808, "lnE", 0 },
+    {  10889, "lnap", 0 },
+    {  10889, "lnapprox", 0 },
+    {  10887, "lne", 0 },
+    {  10887, "lneq", 0 },
+    {   8808, "lneqq", 0 },
+    {   8934, "lnsim", 0 },
+    {  10220, "loang", 0 },
+    {   8701, "loarr", 0 },
+    {  10214, "lobrk", 0 },
+    {  10229, "longleftarrow", 0 },
+    {  10231, "longleftrightarrow", 0 },
+    {  10236, "longmapsto", 0 },
+    {  10230, "longrightarrow", 0 },
+    {   8619, "looparrowleft", 0 },
+    {   8620, "looparrowright", 0 },
+    {  10629, "lopar", 0 },
+    { 120157, "lopf", 0 },
+    {  10797, "loplus", 0 },
+    {  10804, "lotimes", 0 },
+    {   8727, "lowast", 0 },
+    {     95, "lowbar", 0 },
+    {   9674, "loz", 0 },
+    {   9674, "lozenge", 0 },
+    {  10731, "lozf", 0 },
+    {     40, "lpar", 0 },
+    {  10643, "lparlt", 0 },
+    {   8646, "lrarr", 0 },
+    {   8991, "lrcorner", 0 },
+    {   8651, "lrhar", 0 },
+    {  10605, "lrhard", 0 },
+    {   8206, "lrm", 0 },
+    {   8895, "lrtri", 0 },
+    {   8249, "lsaquo", 0 },
+    { 120001, "lscr", 0 },
+    {   8624, "lsh", 0 },
+    {   8818, "lsim", 0 },
+    {  10893, "lsime", 0 },
+    {  10895, "lsimg", 0 },
+    {     91, "lsqb", 0 },
+    {   8216, "lsquo", 0 },
+    {   8218, "lsquor", 0 },
+    {    322, "lstrok", 0 },
+    {     60, "lt", 0 },
+    {  10918, "ltcc", 0 },
+    {  10873, "ltcir", 0 },
+    {   8918, "ltdot", 0 },
+    {   8907, "lthree", 0 },
+    {   8905, "ltimes", 0 },
+    {  10614, "ltlarr", 0 },
+    {  10875, "ltquest", 0 },
+    {  10646, "ltrPar", 0 },
+    {   9667, "ltri", 0 },
+    {   8884, "ltrie", 0 },
+    {   9666, "ltrif", 0 },
+    {  10570, "lurdshar", 0 },
+    {  10598, "luruhar", 0 },
+    {   8808, "lvertneqq", 65024 },
+    {   8808, "lvnE", 65024 },
+    {   8762, "mDDot", 0 },
+    {    175, "macr", 0 },
+    {   9794, "male", 0 },
+    {  10016, "malt", 0 },
+    {  10016, "maltese", 0 },
+    {   8614, "map", 0 },
+    {   8614, "mapsto", 0 },
+    {   8615, "mapstodown", 0 },
+    {   8612, "mapstoleft", 0 },
+    {   8613, "mapstoup", 0 },
+    {   9646, "marker", 0 },
+    {  10793, "mcomma", 0 },
+    {   1084, "mcy", 0 },
+    {   8212, "mdash", 0 },
+    {   8737, "measuredangle", 0 },
+    { 120106, "mfr", 0 },
+    {   8487, "mho", 0 },
+    {    181, "micro", 0 },
+    {   8739, "mid", 0 },
+    {     42, "midast", 0 },
+    {  10992, "midcir", 0 },
+    {    183, "middot", 0 },
+    {   8722, "minus", 0 },
+    {   8863, "minusb", 0 },
+    {   8760, "minusd", 0 },
+    {  10794, "minusdu", 0 },
+    {  10971, "mlcp", 0 },
+    {   8230, "mldr", 0 },
+    {   8723, "mnplus", 0 },
+    {   8871, "models", 0 },
+    { 120158, "mopf", 0 },
+    {   8723, "mp", 0 },
+    { 120002, "mscr", 0 },
+    {   8766, "mstpos", 0 },
+    {    956, "mu", 0 },
+    {   8888, "multimap", 0 },
+    {   8888, "mumap", 0 },
+    {   8921, "nGg", 824 },
+    {   8811, "nGt", 8402 },
+    {   8811, "nGtv", 824 },
+    {   8653, "nLeftarrow", 0 },
+    {   8654, "nLeftrightarrow", 0 },
+    {   8920, "nLl", 824 },
+    {   8810, "nLt", 8402 },
+    {   8810, "nLtv", 824 },
+    {   8655, "nRightarrow", 0 },
+    {   8879, "nVDash", 0 },
+    {   8878, "nVdash", 0 },
+    {   8711, "nabla", 0 },
+    {    324, "nacute", 0 },
+    {   8736, "nang", 8402 },
+    {   8777, "nap", 0 },
+    {  10864, "napE", 824 },
+    {   8779, "napid", 824 },
+    {    329, "napos", 0 },
+    {   8777, "napprox", 0 },
+    {   9838, "natur", 0 },
+    {   9838, "natural", 0 },
+    {   8469, "naturals", 0 },
+    {    160, "nbsp", 0 },
+    {   8782, "nbump", 824 },
+    {   8783, "nbumpe", 824 },
+    {  10819, "ncap", 0 },
+    {    328, "ncaron", 0 },
+    {    326, "ncedil", 0 },
+    {   8775, "ncong", 0 },
+    {  10861, "ncongdot", 824 },
+    {  10818, "ncup", 0 },
+    {   1085, "ncy", 0 },
+    {   8211, "ndash", 0 },
+    {   8800, "ne", 0 },
+    {   8663, "neArr", 0 },
+    {  10532, "nearhk", 0 },
+    {   8599, "nearr", 0 },
+    {   8599, "nearrow", 0 },
+    {   8784, "nedot", 824 },
+    {   8802, "nequiv", 0 },
+    {  10536, "nesear", 0 },
+    {   8770, "nesim", 824 },
+    {   8708, "nexist", 0 },
+    {   8708, "nexists", 0 },
+    { 120107, "nfr", 0 },
+    {   8807, "ngE", 824 },
+    {   8817, "nge", 0 },
+    {   8817, "ngeq", 0 },
+    {   8807, "ngeqq", 824 },
+    {  10878, "ngeqslant", 824 },
+    {  10878, "nges", 824 },
+    {   8821, "ngsim", 0 },
+    {   8815, "ngt", 0 },
+    {   8815, "ngtr", 0 },
+    {   8654, "nhArr", 0 },
+    {   8622, "nharr", 0 },
+    {  10994, "nhpar", 0 },
+    {   8715, "ni", 0 },
+    {   8956, "nis", 0 },
+    {   8954, "nisd", 0 },
+    {   8715, "niv", 0 },
+    {   1114, "njcy", 0 },
+    {   8653, "nlArr", 0 },
+    {   8806, "nlE", 824 },
+    {   8602, "nlarr", 0 },
+    {   8229, "nldr", 0 },
+    {   8816, "nle", 0 },
+    {   8602, "nleftarrow", 0 },
+    {   8622, "nleftrightarrow", 0 },
+    {   8816, "nleq", 0 },
+    {   8806, "nleqq", 824 },
+    {  10877, "nleqslant", 824 },
+    {  10877, "nles", 824 },
+    {   8814, "nless", 0 },
+    {   8820, "nlsim", 0 },
+    {   8814, "nlt", 0 },
+    {   8938, "nltri", 0 },
+    {   8940, "nltrie", 0 },
+    {   8740, "nmid", 0 },
+    { 120159, "nopf", 0 },
+    {    172, "not", 0 },
+    {   8713, "notin", 0 },
+    {   8953, "notinE", 824 },
+    {   8949, "notindot", 824 },
+    {   8713, "notinva", 0 },
+    {   8951, "notinvb", 0 },
+    {   8950, "notinvc", 0 },
+    {   8716, "notni", 0 },
+    {   8716, "notniva", 0 },
+    {   8958, "notnivb", 0 },
+    {   8957, "notnivc", 0 },
+    {   8742, "npar", 0 },
+    {   8742, "nparallel", 0 },
+    {  11005, "nparsl", 8421 },
+    {   8706, "npart", 824 },
+    {  10772, "npolint", 0 },
+    {   8832, "npr", 0 },
+    {   8928, "nprcue", 0 },
+    {  10927, "npre", 824 },
+    {   8832, "nprec", 0 },
+    {  10927, "npreceq", 824 },
+    {   8655, "nrArr", 0 },
+    {   8603, "nrarr", 0 },
+    {  10547, "nrarrc", 824 },
+    {   8605, "nrarrw", 824 },
+    {   8603, "nrightarrow", 0 },
+    {   8939, "nrtri", 0 },
+    {   8941, "nrtrie", 0 },
+    {   8833, "nsc", 0 },
+    {   8929, "nsccue", 0 },
+    {  10928, "nsce", 824 },
+    { 120003, "nscr", 0 },
+    {   8740, "nshortmid", 0 },
+    {   8742, "nshortparallel", 0 },
+    {   8769, "nsim", 0 },
+    {   8772, "nsime", 0 },
+    {   8772, "nsimeq", 0 },
+    {   8740, "nsmid", 0 },
+    {   8742, "nspar", 0 },
+    {   8930, "nsqsube", 0 },
+    {   8931, "nsqsupe", 0 },
+    {   8836, "nsub", 0 },
+    {  10949, "nsubE", 824 },
+    {   8840, "nsube", 0 },
+    {   8834, "nsubset", 8402 },
+    {   8840, "nsubseteq", 0 },
+    {  10949, "nsubseteqq", 824 },
+    {   8833, "nsucc", 0 },
+    {  10928, "nsucceq", 824 },
+    {   8837, "nsup", 0 },
+    {  10950, "nsupE", 824 },
+    {   8841, "nsupe", 0 },
+    {   8835, "nsupset", 8402 },
+    {   8841, "nsupseteq", 0 },
+    {  10950, "nsupseteqq", 824 },
+    {   8825, "ntgl", 0 },
+    {    241, "ntilde", 0 },
+    {   8824, "ntlg", 0 },
+    {   8938, "ntriangleleft", 0 },
+    {   8940, "ntrianglelefteq", 0 },
+    {   8939, "ntriangleright", 0 },
+    {   8941, "ntrianglerighteq", 0 },
+    {    957, "nu", 0 },
+    {     35, "num", 0 },
+    {   8470, "numero", 0 },
+    {   8199, "numsp", 0 },
+    {   8877, "nvDash", 0 },
+    {  10500, "nvHarr", 0 },
+    {   8781, "nvap", 8402 },
+    {   8876, "nvdash", 0 },
+    {   8805, "nvge", 8402 },
+    {     62, "nvgt", 8402 },
+    {  10718, "nvinfin", 0 },
+    {  10498, "nvlArr", 0 },
+    {   8804, "nvle", 8402 },
+    {     60, "nvlt", 8402 },
+    {   8884, "nvltrie", 8402 },
+    {  10499, "nvrArr", 0 },
+    {   8885, "nvrtrie", 8402 },
+    {   8764, "nvsim", 8402 },
+    {   8662, "nwArr", 0 },
+    {  10531, "nwarhk", 0 },
+    {   8598, "nwarr", 0 },
+    {   8598, "nwarrow", 0 },
+    {  10535, "nwnear", 0 },
+    {   9416, "oS", 0 },
+    {    243, "oacute", 0 },
+    {   8859, "oast", 0 },
+    {   8858, "ocir", 0 },
+    {    244, "ocirc", 0 },
+    {   1086, "ocy", 0 },
+    {   8861, "odash", 0 },
+    {    337, "odblac", 0 },
+    {  10808, "odiv", 0 },
+    {   8857, "odot", 0 },
+    {  10684, "odsold", 0 },
+    {    339, "oelig", 0 },
+    {  10687, "ofcir", 0 },
+    { 120108, "ofr", 0 },
+    {    731, "ogon", 0 },
+    {    242, "ograve", 0 },
+    {  10689, "ogt", 0 },
+    {  10677, "ohbar", 0 },
+    {    937, "ohm", 0 },
+    {   8750, "oint", 0 },
+    {   8634, "olarr", 0 },
+    {  10686, "olcir", 0 },
+    {  10683, "olcross", 0 },
+    {   8254, "oline", 0 },
+    {  10688, "olt", 0 },
+    {    333, "omacr", 0 },
+    {    969, "omega", 0 },
+    {    959, "omicron", 0 },
+    {  10678, "omid", 0 },
+    {   8854, "ominus", 0 },
+    { 120160, "oopf", 0 },
+    {  10679, "opar", 0 },
+    {  10681, "operp", 0 },
+    {   8853, "oplus", 0 },
+    {   8744, "or", 0 },
+    {   8635, "orarr", 0 },
+    {  10845, "ord", 0 },
+    {   8500, "order", 0 },
+    {   8500, "orderof", 0 },
+    {    170, "ordf", 0 },
+    {    186, "ordm", 0 },
+    {   8886, "origof", 0 },
+    {  10838, "oror", 0 },
+    {  10839, "orslope", 0 },
+    {  10843, "orv", 0 },
+    {   8500, "oscr", 0 },
+    {    248, "oslash", 0 },
+    {   8856, "osol", 0 },
+    {    245, "otilde", 0 },
+    {   8855, "otimes", 0 },
+    {  10806, "otimesas", 0 },
+    {    246, "ouml", 0 },
+    {   9021, "ovbar", 0 },
+    {   8741, "par", 0 },
+    {    182, "para", 0 },
+    {   8741, "parallel", 0 },
+    {  10995, "parsim", 0 },
+    {  11005, "parsl", 0 },
+    {   8706, "part", 0 },
+    {   1087, "pcy", 0 },
+    {     37, "percnt", 0 },
+    {     46, "period", 0 },
+    {   8240, "permil", 0 },
+    {   8869, "perp", 0 },
+    {   8241, "pertenk", 0 },
+    { 120109, "pfr", 0 },
+    {    966, "phi", 0 },
+    {    981, "phiv", 0 },
+    {   8499, "phmmat", 0 },
+    {   9742, "phone", 0 },
+    {    960, "pi", 0 },
+    {   8916, "pitchfork", 0 },
+    {    982, "piv", 0 },
+    {   8463, "planck", 0 },
+    {   8462, "planckh", 0 },
+    {   8463, "plankv", 0 },
+    {     43, "plus", 0 },
+    {  10787, "plusacir", 0 },
+    {   8862, "plusb", 0 },
+    {  10786, "pluscir", 0 },
+    {   8724, "plusdo", 0 },
+    {  10789, "plusdu", 0 },
+    {  10866, "pluse", 0 },
+    {    177, "plusmn", 0 },
+    {  10790, "plussim", 0 },
+    {  10791, "plustwo", 0 },
+    {    177, "pm", 0 },
+    {  10773, "pointint", 0 },
+    { 120161, "popf", 0 },
+    {    163, "pound", 0 },
+    {   8826, "pr", 0 },
+    {  10931, "prE", 0 },
+    {  10935, "prap", 0 },
+    {   8828, "prcue", 0 },
+    {  10927, "pre", 0 },
+    {   8826, "prec", 0 },
+    {  10935, "precapprox", 0 },
+    {   8828, "preccurlyeq", 0 },
+    {  10927, "preceq", 0 },
+    {  10937, "precnapprox", 0 },
+    {  10933, "precneqq", 0 },
+    {   8936, "precnsim", 0 },
+    {   8830, "precsim", 0 },
+    {   8242, "prime", 0 },
+    {   8473, "primes", 0 },
+    {  10933, "prnE", 0 },
+    {  10937, "prnap", 0 },
+    {   8936, "prnsim", 0 },
+    {   8719, "prod", 0 },
+    {   9006, "profalar", 0 },
+    {   8978, "profline", 0 },
+    {   8979, "profsurf", 0 },
+    {   8733, "prop", 0 },
+    {   8733, "propto", 0 },
+    {   8830, "prsim", 0 },
+    {   8880, "prurel", 0 },
+    { 120005, "pscr", 0 },
+    {    968, "psi", 0 },
+    {   8200, "puncsp", 0 },
+    { 120110, "qfr", 0 },
+    {  10764, "qint", 0 },
+    { 120162, "qopf", 0 },
+    {   8279, "qprime", 0 },
+    { 120006, "qscr", 0 },
+    {   8461, "quaternions", 0 },
+    {  10774, "quatint", 0 },
+    {     63, "quest", 0 },
+    {   8799, "questeq", 0 },
+    {     34, "quot", 0 },
+    {   8667, "rAarr", 0 },
+    {   8658, "rArr", 0 },
+    {  10524, "rAtail", 0 },
+    {  10511, "rBarr", 0 },
+    {  10596, "rHar", 0 },
+    {   8765, "race", 817 },
+    {    341, "racute", 0 },
+    {   8730, "radic", 0 },
+    {  10675, "raemptyv", 0 },
+    {  10217, "rang", 0 },
+    {  10642, "rangd", 0 },
+    {  10661, "range", 0 },
+    {  10217, "rangle", 0 },
+    {    187, "raquo", 0 },
+    {   8594, "rarr", 0 },
+    {  10613, "rarrap", 0 },
+    {   8677, "rarrb", 0 },
+    {  10528, "rarrbfs", 0 },
+    {  10547, "rarrc", 0 },
+    {  10526, "rarrfs", 0 },
+    {   8618, "rarrhk", 0 },
+    {   8620, "rarrlp", 0 },
+    {  10565, "rarrpl", 0 },
+    {  10612, "rarrsim", 0 },
+    {   8611, "rarrtl", 0 },
+    {   8605, "rarrw", 0 },
+    {  10522, "ratail", 0 },
+    {   8758, "ratio", 0 },
+    {   8474, "rationals", 0 },
+    {  10509, "rbarr", 0 },
+    {  10099, "rbbrk", 0 },
+    {    125, "rbrace", 0 },
+    {     93, "rbrack", 0 },
+    {  10636, "rbrke", 0 },
+    {  10638, "rbrksld", 0 },
+    {  10640, "rbrkslu", 0 },
+    {    345, "rcaron", 0 },
+    {    343, "rcedil", 0 },
+    {   8969, "rceil", 0 },
+    {    125, "rcub", 0 },
+    {   1088, "rcy", 0 },
+    {  10551, "rdca", 0 },
+    {  10601, "rdldhar", 0 },
+    {   8221, "rdquo", 0 },
+    {   8221, "rdquor", 0 },
+    {   8627, "rdsh", 0 },
+    {   8476, "real", 0 },
+    {   8475, "realine", 0 },
+    {   8476, "realpart", 0 },
+    {   8477, "reals", 0 },
+    {   9645, "rect", 0 },
+    {    174, "reg", 0 },
+    {  10621, "rfisht", 0 },
+    {   8971, "rfloor", 0 },
+    { 120111, "rfr", 0 },
+    {   8641, "rhard", 0 },
+    {   8640, "rharu", 0 },
+    {  10604, "rharul", 0 },
+    {    961, "rho", 0 },
+    {   1009, "rhov", 0 },
+    {   8594, "rightarrow", 0 },
+    {   8611, "rightarrowtail", 0 },
+    {   8641, "rightharpoondown", 0 },
+    {   8640, "rightharpoonup", 0 },
+    {   8644, "rightleftarrows", 0 },
+    {   8652, "rightleftharpoons", 0 },
+    {   8649, "rightrightarrows", 0 },
+    {   8605, "rightsquigarrow", 0 },
+    {   8908, "rightthreetimes", 0 },
+    {    730, "ring", 0 },
+    {   8787, "risingdotseq", 0 },
+    {   8644, "rlarr", 0 },
+    {   8652, "rlhar", 0 },
+    {   8207, "rlm", 0 },
+    {   9137, "rmoust", 0 },
+    {   9137, "rmoustache", 0 },
+    {  10990, "rnmid", 0 },
+    {  10221, "roang", 0 },
+    {   8702, "roarr", 0 },
+    {  10215, "robrk", 0 },
+    {  10630, "ropar", 0 },
+    { 120163, "ropf", 0 },
+    {  10798, "roplus", 0 },
+    {  10805, "rotimes", 0 },
+    {     41, "rpar", 0 },
+    {  10644, "rpargt", 0 },
+    {  10770, "rppolint", 0 },
+    {   8649, "rrarr", 0 },
+    {   8250, "rsaquo", 0 },
+    { 120007, "rscr", 0 },
+    {   8625, "rsh", 0 },
+    {     93, "rsqb", 0 },
+    {   8217, "rsquo", 0 },
+    {   8217, "rsquor", 0 },
+    {   8908, "rthree", 0 },
+    {   8906, "rtimes", 0 },
+    {   9657, "rtri", 0 },
+    {   8885, "rtrie", 0 },
+    {   9656, "rtrif", 0 },
+    {  10702, "rtriltri", 0 },
+    {  10600, "ruluhar", 0 },
+    {   8478, "rx", 0 },
+    {    347, "sacute", 0 },
+    {   8218, "sbquo", 0 },
+    {   8827, "sc", 0 },
+    {  10932, "scE", 0 },
+    {  10936, "scap", 0 },
+    {    353, "scaron", 0 },
+    {   8829, "sccue", 0 },
+    {  10928, "sce", 0 },
+    {    351, "scedil", 0 },
+    {    349, "scirc", 0 },
+    {  10934, "scnE", 0 },
+    {  10938, "scnap", 0 },
+    {   8937, "scnsim", 0 },
+    {  10771, "scpolint", 0 },
+    {   8831, "scsim", 0 },
+    {   1089, "scy", 0 },
+    {   8901, "sdot", 0 },
+    {   8865, "sdotb", 0 },
+    {  10854, "sdote", 0 },
+    {   8664, "seArr", 0 },
+    {  10533, "searhk", 0 },
+    {   8600, "searr", 0 },
+    {   8600, "searrow", 0 },
+    {    167, "sect", 0 },
+    {     59, "semi", 0 },
+    {  10537, "seswar", 0 },
+    {   8726, "setminus", 0 },
+    {   8726, "setmn", 0 },
+    {  10038, "sext", 0 },
+    { 120112, "sfr", 0 },
+    {   8994, "sfrown", 0 },
+    {   9839, "sharp", 0 },
+    {   1097, "shchcy", 0 },
+    {   1096, "shcy", 0 },
+    {   8739, "shortmid", 0 },
+    {   8741, "shortparallel", 0 },
+    {    173, "shy", 0 },
+    {    963, "sigma", 0 },
+    {    962, "sigmaf", 0 },
+    {    962, "sigmav", 0 },
+    {   8764, "sim", 0 },
+    {  10858, "simdot", 0 },
+    {   8771, "sime", 0 },
+    {   8771, "simeq", 0 },
+    {  10910, "simg", 0 },
+    {  10912, "simgE", 0 },
+    {  10909, "siml", 0 },
+    {  10911, "simlE", 0 },
+    {   8774, "simne", 0 },
+    {  10788, "simplus", 0 },
+    {  10610, "simrarr", 0 },
+    {   8592, "slarr", 0 },
+    {   8726, "smallsetminus", 0 },
+    {  10803, "smashp", 0 },
+    {  10724, "smeparsl", 0 },
+    {   8739, "smid", 0 },
+    {   8995, "smile", 0 },
+    {  10922, "smt", 0 },
+    {  10924, "smte", 0 },
+    {  10924, "smtes", 65024 },
+    {   1100, "softcy", 0 },
+    {     47, "sol", 0 },
+    {  10692, "solb", 0 },
+    {   9023, "solbar", 0 },
+    { 120164, "sopf", 0 },
+    {   9824, "spades", 0 },
+    {   9824, "spadesuit", 0 },
+    {   8741, "spar", 0 },
+    {   8851, "sqcap", 0 },
+    {   8851, "sqcaps", 65024 },
+    {   8852, "sqcup", 0 },
+    {   8852, "sqcups", 65024 },
+    {   8847, "sqsub", 0 },
+    {   8849, "sqsube", 0 },
+    {   8847, "sqsubset", 0 },
+    {   8849, "sqsubseteq", 0 },
+    {   8848, "sqsup", 0 },
+    {   8850, "sqsupe", 0 },
+    {   8848, "sqsupset", 0 },
+    {   8850, "sqsupseteq", 0 },
+    {   9633, "squ", 0 },
+    {   9633, "square", 0 },
+    {   9642, "squarf", 0 },
+    {   9642, "squf", 0 },
+    {   8594, "srarr", 0 },
+    { 120008, "sscr", 0 },
+    {   8726, "ssetmn", 0 },
+    {   8995, "ssmile", 0 },
+    {   8902, "sstarf", 0 },
+    {   9734, "star", 0 },
+    {   9733, "starf", 0 },
+    {   1013, "straightepsilon", 0 },
+    {    981, "straightphi", 0 },
+    {    175, "strns", 0 },
+    {   8834, "sub", 0 },
+    {  10949, "subE", 0 },
+    {  10941, "subdot", 0 },
+    {   8838, "sube", 0 },
+    {  10947, "subedot", 0 },
+    {  10945, "submult", 0 },
+    {  10955, "subnE", 0 },
+    {   8842, "subne", 0 },
+    {  10943, "subplus", 0 },
+    {  10617, "subrarr", 0 },
+    {   8834, "subset", 0 },
+    {   8838, "subseteq", 0 },
+    {  10949, "subseteqq", 0 },
+    {   8842, "subsetneq", 0 },
+    {  10955, "subsetneqq", 0 },
+    {  10951, "subsim", 0 },
+    {  10965, "subsub", 0 },
+    {  10963, "subsup", 0 },
+    {   8827, "succ", 0 },
+    {  10936, "succapprox", 0 },
+    {   8829, "succcurlyeq", 0 },
+    {  10928, "succeq", 0 },
+    {  10938, "succnapprox", 0 },
+    {  10934, "succneqq", 0 },
+    {   8937, "succnsim", 0 },
+    {   8831, "succsim", 0 },
+    {   8721, "sum", 0 },
+    {   9834, "sung", 0 },
+    {   8835, "sup", 0 },
+    {    185, "sup1", 0 },
+    {    178, "sup2", 0 },
+    {    179, "sup3", 0 },
+    {  10950, "supE", 0 },
+    {  10942, "supdot", 0 },
+    {  10968, "supdsub", 0 },
+    {   8839, "supe", 0 },
+    {  10948, "supedot", 0 },
+    {  10185, "suphsol", 0 },
+    {  10967, "suphsub", 0 },
+    {  10619, "suplarr", 0 },
+    {  10946, "supmult", 0 },
+    {  10956, "supnE", 0 },
+    {   8843, "supne", 0 },
+    {  10944, "supplus", 0 },
+    {   8835, "supset", 0 },
+    {   8839, "supseteq", 0 },
+    {  10950, "supseteqq", 0 },
+    {   8843, "supsetneq", 0 },
+    {  10956, "supsetneqq", 0 },
+    {  10952, "supsim", 0 },
+    {  10964, "supsub", 0 },
+    {  10966, "supsup", 0 },
+    {   8665, "swArr", 0 },
+    {  10534, "swarhk", 0 },
+    {   8601, "swarr", 0 },
+    {   8601, "swarrow", 0 },
+    {  10538, "swnwar", 0 },
+    {    223, "szlig", 0 },
+    {   8982, "target", 0 },
+    {    964, "tau", 0 },
+    {   9140, "tbrk", 0 },
+    {    357, "tcaron", 0 },
+    {    355, "tcedil", 0 },
+    {   1090, "tcy", 0 },
+    {   8411, "tdot", 0 },
+    {   8981, "telrec", 0 },
+    { 120113, "tfr", 0 },
+    {   8756, "there4", 0 },
+    {   8756, "therefore", 0 },
+    {    952, "theta", 0 },
+    {    977, "thetasym", 0 },
+    {    977, "thetav", 0 },
+    {   8776, "thickapprox", 0 },
+    {   8764, "thicksim", 0 },
+    {   8201, "thinsp", 0 },
+    {   8776, "thkap", 0 },
+    {   8764, "thksim", 0 },
+    {    254, "thorn", 0 },
+    {    732, "tilde", 0 },
+    {    215, "times", 0 },
+    {   8864, "timesb", 0 },
+    {  10801, "timesbar", 0 },
+    {  10800, "timesd", 0 },
+    {   8749, "tint", 0 },
+    {  10536, "toea", 0 },
+    {   8868, "top", 0 },
+    {   9014, "topbot", 0 },
+    {  10993, "topcir", 0 },
+    { 120165, "topf", 0 },
+    {  10970, "topfork", 0 },
+    {  10537, "tosa", 0 },
+    {   8244, "tprime", 0 },
+    {   8482, "trade", 0 },
+    {   9653, "triangle", 0 },
+    {   9663, "triangledown", 0 },
+    {   9667, "triangleleft", 0 },
+    {   8884, "trianglelefteq", 0 },
+    {   8796, "triangleq", 0 },
+    {   9657, "triangleright", 0 },
+    {   8885, "trianglerighteq", 0 },
+    {   9708, "tridot", 0 },
+    {   8796, "trie", 0 },
+    {  10810, "triminus", 0 },
+    {  10809, "triplus", 0 },
+    {  10701, "trisb", 0 },
+    {  10811, "tritime", 0 },
+    {   9186, "trpezium", 0 },
+    { 120009, "tscr", 0 },
+    {   1094, "tscy", 0 },
+    {   1115, "tshcy", 0 },
+    {    359, "tstrok", 0 },
+    {   8812, "twixt", 0 },
+    {   8606, "twoheadleftarrow", 0 },
+    {   8608, "twoheadrightarrow", 0 },
+    {   8657, "uArr", 0 },
+    {  10595, "uHar", 0 },
+    {    250, "uacute", 0 },
+    {   8593, "uarr", 0 },
+    {   1118, "ubrcy", 0 },
+    {    365, "ubreve", 0 },
+    {    251, "ucirc", 0 },
+    {   1091, "ucy", 0 },
+    {   8645, "udarr", 0 },
+    {    369, "udblac", 0 },
+    {  10606, "udhar", 0 },
+    {  10622, "ufisht", 0 },
+    { 120114, "ufr", 0 },
+    {    249, "ugrave", 0 },
+    {   8639, "uharl", 0 },
+    {   8638, "uharr", 0 },
+    {   9600, "uhblk", 0 },
+    {   8988, "ulcorn", 0 },
+    {   8988, "ulcorner", 0 },
+    {   8975, "ulcrop", 0 },
+    {   9720, "ultri", 0 },
+    {    363, "umacr", 0 },
+    {    168, "uml", 0 },
+    {    371, "uogon", 0 },
+    { 120166, "uopf", 0 },
+    {   8593, "uparrow", 0 },
+    {   8597, "updownarrow", 0 },
+    {   8639, "upharpoonleft", 0 },
+    {   8638, "upharpoonright", 0 },
+    {   8846, "uplus", 0 },
+    {    965, "upsi", 0 },
+    {    978, "upsih", 0 },
+    {    965, "upsilon", 0 },
+    {   8648, "upuparrows", 0 },
+    {   8989, "urcorn", 0 },
+    {   8989, "urcorner", 0 },
+    {   8974, "urcrop", 0 },
+    {    367, "uring", 0 },
+    {   9721, "urtri", 0 },
+    { 120010, "uscr", 0 },
+    {   8944, "utdot", 0 },
+    {    361, "utilde", 0 },
+    {   9653, "utri", 0 },
+    {   9652, "utrif", 0 },
+    {   8648, "uuarr", 0 },
+    {    252, "uuml", 0 },
+    {  10663, "uwangle", 0 },
+    {   8661, "vArr", 0 },
+    {  10984, "vBar", 0 },
+    {  10985, "vBarv", 0 },
+    {   8872, "vDash", 0 },
+    {  10652, "vangrt", 0 },
+    {   1013, "varepsilon", 0 },
+    {   1008, "varkappa", 0 },
+    {   8709, "varnothing", 0 },
+    {    981, "varphi", 0 },
+    {    982, "varpi", 0 },
+    {   8733, "varpropto", 0 },
+    {   8597, "varr", 0 },
+    {   1009, "varrho", 0 },
+    {    962, "varsigma", 0 },
+    {   8842, "varsubsetneq", 65024 },
+    {  10955, "varsubsetneqq", 65024 },
+    {   8843, "varsupsetneq", 65024 },
+    {  10956, "varsupsetneqq", 65024 },
+    {    977, "vartheta", 0 },
+    {   8882, "vartriangleleft", 0 },
+    {   8883, "vartriangleright", 0 },
+    {   1074, "vcy", 0 },
+    {   8866, "vdash", 0 },
+    {   8744, "vee", 0 },
+    {   8891, "veebar", 0 },
+    {   8794, "veeeq", 0 },
+    {   8942, "vellip", 0 },
+    {    124, "verbar", 0 },
+    {    124, "vert", 0 },
+    { 120115, "vfr", 0 },
+    {   8882, "vltri", 0 },
+    {   8834, "vnsub", 8402 },
+    {   8835, "vnsup", 8402 },
+    { 120167, "vopf", 0 },
+    {   8733, "vprop", 0 },
+    {   8883, "vrtri", 0 },
+    { 120011, "vscr", 0 },
+    {  10955, "vsubnE", 65024 },
+    {   8842, "vsubne", 65024 },
+    {  10956, "vsupnE", 65024 },
+    {   8843, "vsupne", 65024 },
+    {  10650, "vzigzag", 0 },
+    {    373, "wcirc", 0 },
+    {  10847, "wedbar", 0 },
+    {   8743, "wedge", 0 },
+    {   8793, "wedgeq", 0 },
+    {   8472, "weierp", 0 },
+    { 120116, "wfr", 0 },
+    { 120168, "wopf", 0 },
+    {   8472, "wp", 0 },
+    {   8768, "wr", 0 },
+    {   8768, "wreath", 0 },
+    { 120012, "wscr", 0 },
+    {   8898, "xcap", 0 },
+    {   9711, "xcirc", 0 },
+    {   8899, "xcup", 0 },
+    {   9661, "xdtri", 0 },
+    { 120117, "xfr", 0 },
+    {  10234, "xhArr", 0 },
+    {  10231, "xharr", 0 },
+    {    958, "xi", 0 },
+    {  10232, "xlArr", 0 },
+    {  10229, "xlarr", 0 },
+    {  10236, "xmap", 0 },
+    {   8955, "xnis", 0 },
+    {  10752, "xodot", 0 },
+    { 120169, "xopf", 0 },
+    {  10753, "xoplus", 0 },
+    {  10754, "xotime", 0 },
+    {  10233, "xrArr", 0 },
+    {  10230, "xrarr", 0 },
+    { 120013, "xscr", 0 },
+    {  10758, "xsqcup", 0 },
+    {  10756, "xuplus", 0 },
+    {   9651, "xutri", 0 },
+    {   8897, "xvee", 0 },
+    {   8896, "xwedge", 0 },
+    {    253, "yacute", 0 },
+    {   1103, "yacy", 0 },
+    {    375, "ycirc", 0 },
+    {   1099, "ycy", 0 },
+    {    165, "yen", 0 },
+    { 120118, "yfr", 0 },
+    {   1111, "yicy", 0 },
+    { 120170, "yopf", 0 },
+    { 120014, "yscr", 0 },
+    {   1102, "yucy", 0 },
+    {    255, "yuml", 0 },
+    {    378, "zacute", 0 },
+    {    382, "zcaron", 0 },
+    {   1079, "zcy", 0 },
+    {    380, "zdot", 0 },
+    {   8488, "zeetrf", 0 },
+    {    950, "zeta", 0 },
+    { 120119, "zfr", 0 },
+    {   1078, "zhcy", 0 },
+    {   8669, "zigrarr", 0 },
+    { 120171, "zopf", 0 },
+    { 120015, "zscr", 0 },
+    {   8205, "zwj", 0 },
+    {   8204, "zwnj", 0 },
+    { 0, NULL, 0 }
+};
+
+#define HTML5_NENT 2125
+#define HTML5_MAXLEN 31
+
+/* Index into html5_ev[] by first character of the name */
+static const short html5_idx[129] = {
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,    0,    0,    0,    0,    0,    0,
+       0,    0,   19,   31,   65,  119,  144,  152,
+     173,  185,  210,  217,  225,  284,  293,  364,
+     387,  406,  410,  454,  494,  516,  552,  569,
+     574,  578,  588,  598,  598,  598,  598,  598,
+     598,  598,  658,  773,  867,  931,  993, 1029,
+    1088, 1116, 1166, 1174, 1184, 1336, 1373, 1538,
+    1591, 1657, 1667, 1769, 1921, 1977, 2024, 2066,
+    2077, 2101, 2112, 2125, 2125, 2125, 2125, 2125,
+    2125,
+};
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+#
+# mkentities.py - Generate entities_html5.h from the HTML5 named
+# character reference list (as shipped with Python's html.entities).
+#
+# Usage: python3 mkentities.py >entities_html5.h
+#
+
+import html.entities
+
+names = sorted(n[:-1] for n in html.entities.html5 if n.endswith(';'))
+
+print("/* entities_html5.h - generated by mkentities.py, do not edit */")
+print()
+print("/* HTML5 named character references, sorted by name */")
+print("static const ENTITY html5_ev[] = {")
+for n in names:
+    v = html.entities.html5[n + ';']
+    c2 = ord(v[1]) if len(v) > 1 else 0
+    print('    { %6d, "%s", %d },' % (ord(v[0]), n, c2))
+print("    { 0, NULL, 0 }")
+print("};")
+print()
+
+# For every (ASCII) first character, the index of the first name starting
+# with that character or a later one.
+print("#define HTML5_NENT %d" % len(names))
+print("#define HTML5_MAXLEN %d" % max(len(n) for n in names))
+print()
+print("/* Index into html5_ev[] by first character of the name */")
+print("static const short html5_idx[129] = {")
+idx = []
+i = 0
+for c in range(129):
+    while i < len(names) and ord(names[i][0]) < c:
+        i += 1
+    idx.append(i)
+for r in range(0, 129, 8):
+    print("    " + " ".join("%4d," % x for x in idx[r:r+8]))
+print("};")
@@ -0,0 +1,217 @@
+/*
+** outbuf.c - Buffered output
+**
+** All CSV output goes through one large user space buffer instead of
+** stdio, so printing a cell is a memcpy() and there is no per character
+** locking. Data that does not fit is written together with the buffer
+** in a single writev(). With fd -1 the output is collected in memory
+** instead (used by the -j workers).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include "outbuf.h"
+
+#define OB_SIZE 65536
+
+
+int
+ob_init(OUTBUF *ob,
+	int fd)
+{
+    ob->fd = fd;
+    ob->len = 0;
+    ob->done = 0;
+    ob->size = OB_SIZE;
+    ob->buf = malloc(ob->size);
+
+    return ob->buf ? 0 : -1;
+}
+
+
+/*
+** Write all of 'iov' to 'fd', restarting after partial writes and
+** interrupts.
+*/
+static int
+write_all(int fd,
+	  struct iovec *iov,
+	  int n)
+{
+    ssize_t got;
+
+
+    while (n > 0)
+    {
+	got = writev(fd, iov, n);
+	if (got < 0)
+	{
+	    if (errno == EINTR)
+		continue;
+	    return -1;
+	}
+
+	while (n > 0 && (size_t) got >= iov->iov_len)
+	{
+	    got -= iov->iov_len;
+	    ++iov;
+	    --n;
+	}
+
+	if (n > 0)
+	{
+	    iov->iov_base = (char *) iov->iov_base + got;
+	    iov->iov_len -= got;
+	}
+    }
+
+    return 0;
+}
+
+
+/* Grow a memory buffer to hold at least 'need' bytes */
+static int
+ob_grow(OUTBUF *ob,
+	size_t need)
+{
+    size_t ns = ob->size;
+    char *nbuf;
+
+
+    while (ns < need)
+	ns *= 2;
+
+    nbuf = realloc(ob->buf, ns);
+    if (!nbuf)
+	return -1;
+
+    ob->buf = nbuf;
+    ob->size = ns;
+    return 0;
+}
+
+
+int
+ob_flush(OUTBUF *ob)
+{
+    struct iovec iov[1];
+
+
+    if (ob->fd < 0 || ob->len == 0)
+	return 0;
+
+    iov[0].iov_base = ob->buf;
+    iov[0].iov_len = ob->len;
+    if (write_all(ob->fd, iov, 1) < 0)
+	return -1;
+
+    ob->done += ob->len;
+    ob->len = 0;
+    return 0;
+}
+
+
+int
+ob_write(OUTBUF *ob,
+	 const char *p,
+	 size_t len)
+{
+    struct iovec iov[2];
+
+
+    if (len <= ob->size - ob->len)
+    {
+	memcpy(ob->buf+ob->len, p, len);
+	ob->len += len;
+	return 0;
+    }
+
+    if (ob->fd < 0)
+    {
+	if (ob_grow(ob, ob->len+len) < 0)
+	    return -1;
+
+	memcpy(ob->buf+ob->len, p, len);
+	ob->len += len;
+	return 0;
+    }
+
+    if (len < ob->size/2)
+    {
+	/* Small - just start over with an empty buffer */
+	if (ob_flush(ob) < 0)
+	    return -1;
+
+	memcpy(ob->buf, p, len);
+	ob->len = len;
+	return 0;
+    }
+
+    /* Write the buffer and the data in one go, without copying */
+    iov[0].iov_base = ob->buf;
+    iov[0].iov_len = ob->len;
+    iov[1].iov_base = (void *) p;
+    iov[1].iov_len = len;
+    if (write_all(ob->fd, iov, 2) < 0)
+	return -1;
+
+    ob->done += ob->len+len;
+    ob->len = 0;
+    return 0;
+}
+
+
+int
+ob_putc_slow(OUTBUF *ob,
+	     int c)
+{
+    char ch = c;
+
+    return ob_write(ob, &ch, 1);
+}
+
+
+int
+ob_puts(OUTBUF *ob,
+	const char *str)
+{
+    return ob_write(ob, str, strlen(str));
+}
+
+
+/* Print a decimal number (without printf) */
+int
+ob_putint(OUTBUF *ob,
+	  long v)
+{
+    char tmp[24], *cp = tmp+sizeof(tmp);
+    unsigned long u = (v < 0 ? -(unsigned long) v : (unsigned long) v);
+
+
+    do
+    {
+	*--cp = '0' + u%10;
+	u /= 10;
+    } while (u);
+
+    if (v < 0)
+	*--cp = '-';
+
+    return ob_write(ob, cp, tmp+sizeof(tmp)-cp);
+}
+
+
+/* Release the buffer (without flushing it) */
+void
+ob_free(OUTBUF *ob)
+{
+    free(ob->buf);
+    ob->buf = NULL;
+    ob->len = ob->size = 0;
+}
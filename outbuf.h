@@ -0,0 +1,49 @@
+/* outbuf.h */
+
+#ifndef PHTX_OUTBUF_H
+#define PHTX_OUTBUF_H
+
+typedef struct outbuf {
+    int fd;       /* Output file descriptor, or -1 to collect in memory */
+    char *buf;
+    size_t len;   /* Bytes in buf */
+    size_t size;
+    size_t done;  /* Bytes written to 'fd' so far */
+} OUTBUF;
+
+
+/* Current output position (bytes written or buffered) */
+#define ob_pos(ob) ((ob)->done + (ob)->len)
+
+#define ob_putc(ob,c) \
+    ((ob)->len < (ob)->size ? ((ob)->buf[(ob)->len++] = (c), 0) : ob_putc_slow((ob), (c)))
+
+
+extern int
+ob_init(OUTBUF *ob,
+	int fd);
+
+extern int
+ob_write(OUTBUF *ob,
+	 const char *p,
+	 size_t len);
+
+extern int
+ob_puts(OUTBUF *ob,
+	const char *str);
+
+extern int
+ob_putint(OUTBUF *ob,
+	  long v);
+
+extern int
+ob_putc_slow(OUTBUF *ob,
+	     int c);
+
+extern int
+ob_flush(OUTBUF *ob);
+
+extern void
+ob_free(OUTBUF *ob);
+
+#endif
@@ -19,23 +19,67 @@
 #include <ctype.h>
 #include <errno.h>
 #include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <pthread.h>
 
+#include "arena.h"
 #include "entities.h"
+#include "charset.h"
+#include "scan.h"
+#include "outbuf.h"
+#include "arrow.h"
+#include "stats.h"
+#include "attr.h"
+#include "select.h"
 
-#define DEF_CELLS 32
-#define DEF_ROWS  64
+#define DEF_CELLS  32
+#define MAX_COLS   (1024*1024) /* Highest column number for -C */
+#define DEF_ROWS   64
+#define DEF_TABLES 16
+#define DEF_POOL   4096
+
+/* Largest row and column spans (as in HTML) */
+#define MAX_ROWSPAN 65534
+#define MAX_COLSPAN 1000
 
 #define DEF_BUFSIZE 32768
 
+/* Default min size of the chunks large files are split into with -j */
+#define SPLIT_MIN (256*1024)
+
+/* Max number of bytes the parser looks ahead of the current position */
+#define LOOKAHEAD 8
+
+/* Parsed input is given back to the system in steps of this size */
+#define MAP_RELEASE (1024*1024)
+
+#if defined(MAP_ANON) && !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
 extern char version[];
 
-/* TODO: Make dynamic */
+/* Max rows in an Arrow record batch */
+#define ARROW_ROWS 65536
+
+/* Max table nesting depth */
 #define MAXTABLES 256
 
-#define NBSP (char) 160
-#define is_space(c) (isspace(c) || (c == NBSP))
+/* Length of the white space character (ASCII or UTF-8 NBSP) at p, or 0 */
+#define sp_len(p,end) \
+    (isspace((unsigned char) *(p)) ? 1 : \
+     ((end)-(p) >= 2 && (p)[0] == '\302' && (p)[1] == '\240') ? 2 : 0)
+
+/* Same for the one ending just before 'end' */
+#define sp_len_back(start,end) \
+    (isspace((unsigned char) (end)[-1]) ? 1 : \
+     ((end)-(start) >= 2 && (end)[-2] == '\302' && (end)[-1] == '\240') ? 2 : 0)
 
 
 char *img_magic = NULL;
@@ -48,44 +92,227 @@ int span_repeat = 0;
 int p_caption = 0;
 int p_rowno = 0;
 int p_strip = 0;
+int p_squeeze = 0;         /* One blank per tag, comment or nested table (-b) */
 
 char *delim = ";";
 char *match = NULL;
 char *empty = NULL;
-int m_no = 0;
+int m_no = 0;              /* Id of the -M table, if known */
+int m_id = 0;              /* -M selects by table number */
+int m_one = 0;             /* -M selects a single table (no ids printed) */
+SELECTOR *sel = NULL;      /* Compiled -M */
+int drain = 0;             /* Read streams to the end after the -M table (-a) */
+int stats = 0;             /* Print statistics (-T, -TT as JSON) */
+
+/* Column (-C) and row (-L) projection, 0-based */
+unsigned char *col_map = NULL; /* Selected columns up to col_max */
+int col_max = -1;
+int col_from = INT_MAX;        /* All columns from here on ("N-") */
+int row_first = 0;
+int row_last = INT_MAX;
+int projecting = 0;            /* -C or -L given */
+
+char *argv0 = "phtx";
+
+int jobs = 1;              /* Files parsed in parallel (-j) */
+size_t split_min = SPLIT_MIN; /* Min size of a chunk of a split file (-j) */
+
+int in_charset = -1;       /* Forced input charset (-i) */
+int out_charset = CS_UTF8; /* Output charset (-e) */
+
+/* Output formats (-F) */
+#define FMT_CSV     0
+#define FMT_ARROW   1
+#define FMT_RFC4180 2
+#define FMT_TSV     3
+#define FMT_JSONL   4
+
+int out_format = FMT_CSV;
+char *eol = "\n";
+
+
+/*
+** Text left out of the open cell of a table (a tag, a comment or a
+** nested table), see table_hole().
+*/
+typedef struct hole {
+    size_t off;  /* Offset from the start of the cell */
+    size_t len;
+} HOLE;
+
+/* Tags known by the parser, see tag_class() */
+#define TAG_OTHER       0
+#define TAG_IMG         1
+#define TAG_TABLE       2
+#define TAG_TABLE_END   3
+#define TAG_TR          4
+#define TAG_TR_END      5
+#define TAG_CAPTION     6
+#define TAG_CAPTION_END 7
+#define TAG_TD          8
+#define TAG_TD_END      9
+#define TAG_TH          10
+#define TAG_TH_END      11
+#define TAG_SCRIPT      12
+#define TAG_STYLE       13
+
+/* Only counted for -T (never returned by tag_class()) */
+#define TAG_COMMENT     14
+#define TAG_CDATA       15
+
+/* Tag class names for -T */
+const char *tag_names[] = {
+    "other", "img", "table", "/table", "tr", "/tr", "caption", "/caption",
+    "td", "/td", "th", "/th", "script", "style", "comment", "cdata", NULL
+};
+
+/* Parser states */
+#define PS_TEXT    0
+#define PS_TAG     1
+#define PS_COMMENT 2  /* Raw text (see raw_end()) from here on */
+#define PS_SCRIPT  3
+#define PS_STYLE   4
+#define PS_CDATA   5
+
+
+/*
+** A cell is a slice of the table string pool, or (CELL_REF) of the
+** input buffer when its text needed no decoding. The top bits of 'len'
+** tell whether the cell has been filled at all, and if it was filled
+** by a row/colspan of another cell (text only kept with -R).
+*/
+typedef struct cell {
+    unsigned int off;  /* Offset of the text in the string pool */
+    unsigned int len;  /* Length of the text | CELL_* flags */
+} CELL;
+
+#define CELL_SET     0x80000000U
+#define CELL_SPAN    0x40000000U
+#define CELL_REF     0x20000000U
+#define CELL_LENMASK 0x1FFFFFFFU
+
+#define CELL_LEN(c)  ((c).len & CELL_LENMASK)
+#define CELL_TEXT(tp,c) \
+    ((((c).len & CELL_REF) ? (tp)->src : (tp)->pool) + (c).off)
+
+
+/*
+** A rowspan reaching into rows that are not open yet. The rows get
+** their copies of the cell when they are opened, see table_row_open().
+*/
+typedef struct span {
+    int row;    /* Last row covered */
+    int col;    /* First column */
+    int n;      /* Columns covered */
+    CELL text;
+} SPAN;
 
 
 typedef struct tablerow {
-    int cc; /* Current cell */
-    int cm; /* Last cell */
-    int cs; /* Cell vector size */
-    char **cv;
+    int cc;   /* Current cell */
+    int cm;   /* Last cell */
+    int cs;   /* Cell vector size */
+    CELL *cv; /* Cell vector (NULL if the row is not created yet) */
 } TABLEROW;
 
 
 typedef struct table {
     int id;
-    char *caption; /* Table caption */
+    ARENA arena;      /* Row and cell vectors */
+    
+    char *pool;       /* Text of all cells, back to back */
+    size_t pool_len;
+    size_t pool_size;
+    int pool_allocs;  /* Times the pool was (re)allocated */
+    const char *src;  /* Input buffer CELL_REF cells point into */
+    
+    CELL caption;     /* Table caption */
     
     char *ta_s;
-    char *td_s;    /* Start of TD tag */
+    char *td_s;       /* Start of TD tag */
+
+    int hc;           /* Holes in the open cell */
+    int hs;
+    HOLE *hv;
+
+    int sc;           /* Active rowspans */
+    int ss;
+    SPAN *sv;
+    unsigned long long span_cells; /* Cells filled by spans (for -T) */
     
-    int cm;        /* Max cm in any row */
+    int cm;           /* Max cm in any row */
+    int skip;         /* Not selected - only tracked for nesting */
+    int pend;         /* -M conditions still to be seen (PEND_*) */
+    int nc;           /* Cells started in the open row */
 
-    TABLEROW *rp;  /* Currently open row */
-    int rc;        /* Current row */
-    int rs;        /* Row vector size */
-    TABLEROW **rv; /* Row vector */
+    int ro;           /* Row 'rc' is open */
+    int rc;           /* Current row */
+    int rs;           /* Row vector size */
+    TABLEROW *rv;     /* Row vector */
 } TABLE;
 
 
-/* Tables */
-int tc;
-TABLE *tv[MAXTABLES];
+/* Parts of the -M selector a table is kept for until they are seen */
+#define PEND_CAPTION 1
+#define PEND_CELLS   2
+
+
+/* Start of an output line of a -j worker, see table_print_csv() */
+typedef struct linerec {
+    long pos;
+    int id;
+} LINEREC;
+
+/* Table ids inside the (Arrow) output of a -j worker, see job_merge() */
+typedef struct idpatch {
+    size_t pos;
+    int n;
+} IDPATCH;
+
+
+typedef struct parser {
+    const char *path;    /* Input file name (for messages) */
+    OUTBUF *out;         /* Output buffer */
+    const char *outpath; /* Output file name (for messages) */
+    
+    int state;           /* PS_* */
+    char *sp;            /* Start of current tag or comment */
+    int lastc;           /* Previous character (-1 at start of file) */
+    int line;            /* Current line number */
+    int charset;         /* Input charset, see charset.h */
+    
+    TABLE *tp;           /* Innermost open table */
+    int rowspan;
+    int colspan;
+    int skip_cell;
+    
+    const char *base;    /* Mapped input, cells may point into it (NULL if streaming) */
+    size_t size;
+    const char *kept;    /* Mapped input before this is given back */
 
-/* Tablestack */
-int tsc = 0;
-TABLE *tsv[MAXTABLES];
+    int tn;              /* Tables opened so far (used for id numbering) */
+    int m_first;         /* First table matching -M (-j workers only) */
+    int done;            /* The -M table is complete, stop parsing */
+    
+    int tc;              /* Tables waiting to be printed */
+    int ts;
+    TABLE **tv;
+    
+    int tsc;             /* Table stack */
+    TABLE *tsv[MAXTABLES];
+    
+    size_t mem_used;     /* Arena memory of all freed tables */
+    size_t mem_size;
+    STATS st;            /* Counters and timings for -T */
+    
+    int tagged;          /* Print ids as line records (-j workers) */
+    int lc;
+    int ls;
+    LINEREC *lv;
+    int pc;
+    int ps;
+    IDPATCH *pv;
+} PARSER;
 
 
 int
@@ -97,16 +324,19 @@ table_row_close(TABLE *tp)
     if (debug)
 	fprintf(stderr, "table_row_close(tp->id=%d, tp->rc=%d)\n", tp->id, tp->rc);
 
-    if (tp == NULL || tp->rp == NULL)
+    if (tp == NULL || !tp->ro)
 	return -1;
     
-    rp = tp->rp;
+    if (!tp->skip && tp->rc <= row_last)
+    {
+	rp = &tp->rv[tp->rc];
 
-    /* Update table max cell idx */
-    if (rp->cm > tp->cm)
-	tp->cm = rp->cm;
+	/* Update table max cell idx */
+	if (rp->cm > tp->cm)
+	    tp->cm = rp->cm;
+    }
 
-    tp->rp = NULL;
+    tp->ro = 0;
     
     return tp->rc++;
 }
@@ -117,96 +347,212 @@ TABLEROW *
 table_row_create(TABLE *tp,
 		 int row)
 {
-    int i, j;
-    TABLEROW *rp = NULL;
+    int i;
+    TABLEROW *rp;
     
 
     if (debug)
 	fprintf(stderr, "table_row_create(tp->id=%d, row=%d) : tp->rc=%d\n", tp->id, row, tp->rc);
     
-    /* Allocate all rows up to and including the target row */
-    for (i = tp->rc; i <= row; i++)
+    /* Need more row space? */
+    if (row >= tp->rs)
     {
-	/* Need more row space? */
-        if (i >= tp->rs)
-	{
-	    TABLEROW **nrv;
+	TABLEROW *nrv;
+	int ns = tp->rs*2;
 
+	while (ns <= row)
+	    ns *= 2;
+	
+	if (debug)
+	    fprintf(stderr, "  -> resizing row vector, new size=%d\n", ns);
+	
+	nrv = arena_grow(&tp->arena, tp->rv,
+			 sizeof(tp->rv[0])*tp->rs, sizeof(tp->rv[0])*ns);
+	if (nrv == NULL)
+	{
 	    if (debug)
-		fprintf(stderr, "  -> resizing row vector, new size=%d\n", tp->rs+DEF_ROWS);
-	    
-	    nrv = realloc(tp->rv, sizeof(tp->rv[0])*(tp->rs+DEF_ROWS));
-	    if (nrv == NULL)
-	    {
-		if (debug)
-		    fprintf(stderr, "   -> realloc failed\n");
-		return NULL;
-	    }
-
-	    tp->rv = nrv;
-	    tp->rs += DEF_ROWS;
-	    
-	    for (j = tp->rc; j < tp->rs; j++)
-		tp->rv[j] = NULL;
+		fprintf(stderr, "   -> arena_grow failed\n");
+	    return NULL;
 	}
 	
-	if (tp->rv[i] == NULL)
+	memset(nrv+tp->rs, 0, sizeof(nrv[0])*(ns-tp->rs));
+	tp->rv = nrv;
+	tp->rs = ns;
+    }
+    
+    /* Allocate all rows up to and including the target row */
+    for (i = tp->rc; i <= row; i++)
+    {
+	rp = &tp->rv[i];
+	if (rp->cv == NULL)
 	{
 	    if (debug)
 		fprintf(stderr, "   -> allocating new row\n");
 	    
-	    rp = malloc(sizeof(TABLEROW));
-	    if (!rp)
-		return NULL;
-	    
-	    rp->cc = 0;
-	    rp->cm = 0;
-	    rp->cs = DEF_CELLS;
-	    rp->cv = malloc(sizeof(char *) * rp->cs);
+	    rp->cv = arena_alloc(&tp->arena, sizeof(CELL) * DEF_CELLS);
 	    if (rp->cv == NULL)
 	    {
 		if (debug)
 		    fprintf(stderr, "  -> allocation of row cells failed\n");
 		
-		free(rp);
 		return NULL;
 	    }
 	    
-	    for (j = 0; j < rp->cs; j++)
-		rp->cv[j] = NULL;
-
-	    tp->rv[i] = rp;
+	    memset(rp->cv, 0, sizeof(CELL) * DEF_CELLS);
+	    rp->cc = 0;
+	    rp->cm = 0;
+	    rp->cs = DEF_CELLS;
 	}
     }
 
     if (debug)
-	fprintf(stderr, "   -> returning row=%p\n", tp->rv[row]);
+	fprintf(stderr, "   -> returning row=%d\n", row);
+    
+    return &tp->rv[row];
+}
+
+
+/*
+** Make room for cell 'cc' in row 'rp' and return it. The row and table
+** widths are updated to include it.
+*/
+CELL *
+table_row_cell(TABLE *tp,
+	       TABLEROW *rp,
+	       int cc)
+{
+    CELL *ncv;
+    int ns;
+
+    
+    if (cc >= rp->cs)
+    {
+	ns = rp->cs*2;
+	if (ns <= cc)
+	    ns = cc+DEF_CELLS;
+	
+	ncv = arena_grow(&tp->arena, rp->cv,
+			 sizeof(CELL) * rp->cs, sizeof(CELL) * ns);
+	if (!ncv)
+	    return NULL;
+	
+	memset(ncv+rp->cs, 0, sizeof(CELL) * (ns-rp->cs));
+	rp->cv = ncv;
+	rp->cs = ns;
+    }
+    
+    if (cc > rp->cm)
+	rp->cm = cc;
+    if (cc > tp->cm)
+	tp->cm = cc;
     
-    return tp->rv[row];
+    return &rp->cv[cc];
 }
 
+
+/*
+** Store a copy of 'text' filling a cell covered by a row or column
+** span. Without -R only its place is kept, not the text.
+**
+** Column spans are filled in eagerly, on purpose. Unlike a rowspan a
+** colspan only widens its own row, at most MAX_COLSPAN cells, and
+** every one of those cells is printed as a field anyway. So a cell
+** vector entry per printed field is the most it can cost, and the
+** printers need not know about spans.
+*/
+int
+table_span_cell(TABLE *tp,
+		TABLEROW *rp,
+		int cc,
+		const CELL *text)
+{
+    CELL *cp;
+
+
+    cp = table_row_cell(tp, rp, cc);
+    if (!cp)
+	return -1;
+
+    *cp = *text;
+    if (!span_repeat)
+	cp->len = CELL_SET;
+    cp->len |= CELL_SPAN;
     
+    tp->span_cells++;
+    return 0;
+}
+
+
+/*
+** Fill the cells of the open row covered by rowspans from above, and
+** forget the rowspans that end with it.
+*/
 int
-table_row_open(TABLE *tp)
+table_span_fill(TABLE *tp)
 {
-    TABLEROW *rp;
+    TABLEROW *rp = &tp->rv[tp->rc];
+    SPAN *sp;
+    int i, j, c;
+    
+
+    for (i = j = 0; i < tp->sc; i++)
+    {
+	sp = &tp->sv[i];
+	if (sp->row < tp->rc)
+	    continue;
+	
+	for (c = 0; c < sp->n; c++)
+	    if (table_span_cell(tp, rp, sp->col+c, &sp->text) < 0)
+		return -1;
+	
+	if (sp->row > tp->rc)
+	    tp->sv[j++] = *sp;
+    }
+    
+    tp->sc = j;
+    return 0;
+}
+
+
+/*
+** The table can't satisfy the -M selector anymore. What is stored of
+** it is dropped when it is printed, nothing more is stored.
+*/
+void
+table_reject(TABLE *tp)
+{
+    if (debug)
+	fprintf(stderr, "table_reject(tp->id=%d)\n", tp->id);
+
+    tp->skip = 1;
+    tp->pend = 0;
+}
 
     
-    if (tp->rp != NULL)
+int
+table_row_open(TABLE *tp)
+{
+    if (tp->ro)
 	return -1;
     
     if (debug)
 	fprintf(stderr, "table_row_open(id=%d): tp->rc=%d\n", tp->id, tp->rc);
 
-    rp = table_row_create(tp, tp->rc);
-    if (!rp)
+    /* No caption before the rows, or past the row of the -M cells */
+    if ((tp->pend & PEND_CAPTION) ||
+	((tp->pend & PEND_CELLS) && sel->row && tp->rc >= sel->row))
+	table_reject(tp);
+
+    if (!tp->skip && tp->rc <= row_last &&
+	(!table_row_create(tp, tp->rc) || table_span_fill(tp) < 0))
     {
 	if (debug)
 	    fprintf(stderr, "  -> table_row_create failed\n");
 	return -1;
     }
 
-    tp->rp = tp->rv[tp->rc];
+    tp->ro = 1;
+    tp->nc = 0;
 
     if (debug)
 	fprintf(stderr, "  -> row %d opened\n", tp->rc);
@@ -216,135 +562,345 @@ table_row_open(TABLE *tp)
 
 
 
+/*
+** Will table 'id' be printed? 'hit' tells if its TABLE tag satisfies
+** the -M selector. Tables ruled out are only tracked for nesting and
+** numbering, their cells are never stored. -j workers don't know the
+** final table ids, so they leave the :nth() check to job_merge().
+*/
+int
+table_wanted(PARSER *pp,
+	     int id,
+	     int hit)
+{
+    if (!match)
+	return 1;
+
+    /* Plain text, the first table with it */
+    if (sel->text)
+	return id == (pp->tagged ? pp->m_first : m_no);
+
+    if (!hit)
+	return 0;
+
+    return pp->tagged || !m_id || id == m_no;
+}
+
+
+/*
+** Is 'tp' the last table we need, the one selected by -M? Nothing
+** after it can be printed, so parsing stops when it is closed. That is
+** also true if it was the :nth() table but failed the other conditions.
+*/
+int
+table_is_last(PARSER *pp,
+	      TABLE *tp)
+{
+    if (!match || tp->pend)
+	return 0;
+
+    if (pp->tagged)
+	return !m_id && tp->id == pp->m_first;
+
+    return m_no && tp->id == m_no;
+}
+
+
 TABLE *
-table_open(void)
+table_open(PARSER *pp,
+	   int hit)
 {
-    int i;
     TABLE *tp;
 
 
+    if (pp->tsc >= MAXTABLES)
+    {
+	if (debug)
+	    fprintf(stderr, "table_open(): max nesting depth (%d) reached\n", MAXTABLES);
+	return NULL;
+    }
+
+    /* Need more space in the pending table vector? */
+    if (pp->tc >= pp->ts)
+    {
+	TABLE **ntv;
+
+	ntv = realloc(pp->tv, sizeof(pp->tv[0])*(pp->ts+DEF_TABLES));
+	if (ntv == NULL)
+	    return NULL;
+
+	pp->tv = ntv;
+	pp->ts += DEF_TABLES;
+    }
+    
     tp = malloc(sizeof(TABLE));
     if (!tp)
 	return NULL;
 
-    tp->id = tc+1;
-    tp->caption = NULL;
+    tp->id = ++pp->tn;
+    arena_init(&tp->arena);
+    tp->pool = NULL;
+    tp->pool_len = 0;
+    tp->pool_size = 0;
+    tp->pool_allocs = 0;
+    tp->src = NULL;
+    tp->caption.off = 0;
+    tp->caption.len = 0;
     
     tp->rc = 0;
-    tp->rp = NULL;
+    tp->ro = 0;
     
     tp->cm = 0;
     tp->ta_s = NULL;
     tp->td_s = NULL;
-
+    tp->hc = 0;
+    tp->hs = 0;
+    tp->hv = NULL;
+    tp->sc = 0;
+    tp->ss = 0;
+    tp->sv = NULL;
+    tp->span_cells = 0;
+    tp->skip = !table_wanted(pp, tp->id, hit);
+    tp->pend = 0;
+    tp->nc = 0;
+    if (match && !tp->skip)
+	tp->pend = (sel->caption ? PEND_CAPTION : 0) | (sel->cells ? PEND_CELLS : 0);
+    tp->rv = NULL;
+    tp->rs = 0;
     
     if (debug)
-	fprintf(stderr, "table_open(): id=%d, tsc=%d\n", tp->id, tsc);
+	fprintf(stderr, "table_open(): id=%d, tsc=%d%s\n", tp->id, pp->tsc,
+		tp->skip ? " (skipped)" : "");
 
-    tp->rv = malloc(sizeof(tp->rv[0])*DEF_ROWS);
+    if (tp->skip)
+    {
+	pp->tv[pp->tc++] = pp->tsv[pp->tsc++] = tp;
+	return tp;
+    }
+    
+    tp->rv = arena_alloc(&tp->arena, sizeof(tp->rv[0])*DEF_ROWS);
     if (tp->rv == NULL)
+    {
+	arena_free(&tp->arena);
+	free(tp);
 	return NULL;
+    }
     tp->rs = DEF_ROWS;
+    memset(tp->rv, 0, sizeof(tp->rv[0])*tp->rs);
     
-    for (i = 0; i < tp->rs; i++)
-	tp->rv[i] = NULL;
-    
-    tv[tc++] = tsv[tsc++] = tp;
+    pp->tv[pp->tc++] = pp->tsv[pp->tsc++] = tp;
     
     return tp;
 }
 
 
+void
+table_free(PARSER *pp,
+	   TABLE *tp)
+{
+    if (debug)
+	fprintf(stderr, "table_free(tp->id=%d): %lu bytes used, %lu allocated\n",
+		tp->id, (unsigned long) (tp->arena.used + tp->pool_len),
+		(unsigned long) (tp->arena.size + tp->pool_size));
+
+    pp->mem_used += tp->arena.used + tp->pool_len;
+    pp->mem_size += tp->arena.size + tp->pool_size;
+    pp->st.allocs += 1 + tp->arena.blocks + tp->pool_allocs;
+    pp->st.alloc_bytes += sizeof(TABLE) + tp->arena.size + tp->pool_size;
+    pp->st.span_cells += tp->span_cells;
+    
+    arena_free(&tp->arena);
+    free(tp->hv);
+    free(tp->pool);
+    free(tp);
+}
+
+
 TABLE *
-table_close(TABLE *tp)
+table_close(PARSER *pp,
+	    TABLE *tp)
 {
     if (debug)
-	fprintf(stderr, "table_close(tp->id=%d, tp->rc=%d), tsc=%d\n", tp->id, tp->rc, tsc);
+	fprintf(stderr, "table_close(tp->id=%d, tp->rc=%d), tsc=%d\n", tp->id, tp->rc, pp->tsc);
 
-    if (tp->rp)
+    if (tp->ro)
 	return NULL;
     
-    --tsc;
-    if (tsc == 0)
+    --pp->tsc;
+    if (pp->tsc == 0)
 	return NULL;
 
-    return tsv[tsc-1];
+    return pp->tsv[pp->tsc-1];
+}
+
+
+/*
+** Leave the text from 'start' up to and including 'end' (a tag, a
+** nested table or raw text like a comment or script) out of the open
+** cell of 'tp'. The input buffer is never written to (a memory mapped
+** file stays clean), the holes are blanked in the copy of the cell text
+** instead.
+*/
+int
+table_hole(TABLE *tp,
+	   char *start,
+	   char *end)
+{
+    HOLE *nhv;
+    int ns;
+
+
+    /* Cells of tables -M will not print are never stored */
+    if (tp->skip || !tp->td_s || !start || start < tp->td_s)
+	return 0;
+
+    if (tp->hc >= tp->hs)
+    {
+	ns = tp->hs ? tp->hs*2 : 4;
+	nhv = realloc(tp->hv, sizeof(HOLE)*ns);
+	if (!nhv)
+	    return -1;
+
+	tp->hv = nhv;
+	tp->hs = ns;
+    }
+
+    tp->hv[tp->hc].off = start - tp->td_s;
+    tp->hv[tp->hc].len = end+1 - start;
+    tp->hc++;
+    return 0;
+}
+
+
+
+/* First selected (-C) column at or after 'c' */
+int
+col_next(int c)
+{
+    if (!col_map)
+	return c;
+
+    while (c <= col_max && !col_map[c])
+	++c;
+
+    return (c <= col_max || c >= col_from) ? c : col_from;
+}
+
+
+/*
+** Can the text of a cell at row 'row', column 'col' be printed? Only
+** the cell itself is printed, unless its spans are filled with it (-R).
+** The row and column a span touches are not easily predicted when it
+** covers both several rows and columns (see table_append()), so those
+** are always kept.
+*/
+int
+cell_wanted(int row,
+	    int col,
+	    int rowspan,
+	    int colspan)
+{
+    if (!span_repeat)
+	rowspan = colspan = 1;
+    else if (rowspan > 1 && colspan > 1)
+	return 1;
+
+    if (row > row_last || row+rowspan-1 < row_first)
+	return 0;
+
+    return colspan > 0 && col_next(col) <= col+colspan-1;
 }
 
 
+/*
+** Position of the next cell in the open row, after any cells already
+** filled by a rowspan from above.
+*/
+int
+table_next_cell(TABLE *tp)
+{
+    TABLEROW *rp;
+
+    
+    if (!tp->ro)
+	return -1;
+    
+    rp = &tp->rv[tp->rc];
+    while (rp->cc <= rp->cm && (rp->cv[rp->cc].len & CELL_SET))
+	rp->cc++;
+
+    return rp->cc;
+}
 
+
+/*
+** Store the text of a cell at the current position in the open row,
+** and fill the cells covered by its colspan. A rowspan is only noted,
+** the rows below get their copies of the cell when they are opened
+** (rows that never are cost nothing).
+*/
 int
 table_append(TABLE *tp,
-	     char *buf,
+	     const CELL *text,
 	     int rowspan,
 	     int colspan)
 {
     TABLEROW *rp;
-    int i, nr, nc;
+    CELL *cp;
+    SPAN *nsv;
+    int nc, ns;
     int cc;
 
 
     if (debug)
-	fprintf(stderr, "table_append(tp->id=%d, rowspan=%d, colspan=%d, \"%s\")\n",
-		tp ? tp->id : -1, rowspan, colspan, buf);
+	fprintf(stderr, "table_append(tp->id=%d, rowspan=%d, colspan=%d, \"%.*s\")\n",
+		tp ? tp->id : -1, rowspan, colspan,
+		tp ? (int) CELL_LEN(*text) : 0, tp ? CELL_TEXT(tp, *text) : "");
     
     if (tp == NULL)
 	return -1;
     
-    if (tp->rp == NULL)
+    if (!tp->ro || colspan < 1)
 	return -1;
     
-    rp = tp->rp;
+    rp = &tp->rv[tp->rc];
 	
     if (debug)
 	fprintf(stderr, "  -> tp->rc=%d, tp->cm=%d, rp->cc=%d, rp->cs=%d\n", 
 		tp->rc, tp->cm, rp->cc, rp->cs);
     
     /* Skip pre-filled rowspan:d cells */
-    while (rp->cc <= rp->cm && rp->cv[rp->cc] != NULL)
-	rp->cc++;
+    cc = table_next_cell(tp);
 
-    cc = 0;
-    /* Insert cell data */
-    for (nc = 0; nc < colspan; nc++)
+    cp = table_row_cell(tp, rp, cc);
+    if (!cp)
+	return -1;
+    *cp = *text;
+    
+    for (nc = 1; nc < colspan; nc++)
+	if (table_span_cell(tp, rp, cc+nc, text) < 0)
+	    return -1;
+    rp->cc = cc+colspan;
+
+    if (rowspan > 1)
     {
-	cc = rp->cc++;
-	nr = 0;
-	for (i = tp->rc; nr < rowspan; i++, nr++)
+	if (tp->sc >= tp->ss)
 	{
-	    if (tp->rv[i] == NULL)
-	    {
-		rp = table_row_create(tp, i);
-		if (!rp)
-		    return -1;
-	    }
-	    else
-		rp = tp->rv[i];
+	    ns = tp->ss ? tp->ss*2 : DEF_CELLS;
+	    nsv = arena_grow(&tp->arena, tp->sv,
+			     sizeof(SPAN) * tp->ss, sizeof(SPAN) * ns);
+	    if (!nsv)
+		return -1;
 	    
-	    if (cc >= rp->cs)
-	    {
-		int j;
-		
-		rp->cs = cc+DEF_CELLS;
-		
-		rp->cv = realloc(rp->cv, sizeof(char *) * rp->cs);
-		for (j = rp->cc; j < rp->cs; j++)
-		    rp->cv[j] = NULL;
-		
-		if (!rp)
-		    return -1;
-	    }
-	    
-	    if (span_repeat || (nr == 0 && nc == 0))
-		rp->cv[cc] = strdup(buf);
-	    else
-		rp->cv[cc] = strdup(""); /* strdup(empty ? empty : ""); */
-	    
-	    if (cc > rp->cm)
-		rp->cm = cc;
-	    if (cc > tp->cm)
-		tp->cm = cc;
+	    tp->sv = nsv;
+	    tp->ss = ns;
 	}
+
+	tp->sv[tp->sc].row = tp->rc+rowspan-1;
+	tp->sv[tp->sc].col = cc;
+	tp->sv[tp->sc].n = colspan;
+	tp->sv[tp->sc].text = *text;
+	tp->sc++;
     }
     
     return cc;
@@ -352,369 +908,3009 @@ table_append(TABLE *tp,
 
 
 
+void *memmem(const void *haystack, size_t hlen, const void *needle, size_t nlen)
+{
+    int needle_first;
+    const void *p = haystack;
+    size_t plen = hlen;
+    
+    if (!nlen)
+	return NULL;
+    
+    needle_first = *(unsigned char *)needle;
+    
+    while (plen >= nlen && (p = memchr(p, needle_first, plen - nlen + 1)))
+    {
+	if (!memcmp(p, needle, nlen))
+	    return (void *)p;
+	
+	p++;
+	plen = hlen - (p - haystack);
+    }
+    
+    return NULL;
+}
+
+/*
+** Print a cell (UTF-8) quoted and escaped as needed, converting it to
+** the output charset. Characters the output charset can not represent
+** are printed as '?'. Runs of text that need no escaping are found
+** with memchr() and copied as is (cell text is always valid UTF-8).
+*/
 int
 puts_csv(const char *buf,
-	 FILE *fp)
+	 size_t len,
+	 OUTBUF *ob)
 {
     int quote = 0;
-    int lastc = 0;
-    const char *end;
+    int lastsp = 0;
+    int c, n;
+    const char *end, *tail, *p, *q;
     
 
-    if (!buf || !*buf)
+    if (!buf || len == 0)
     {
 	if (empty)
-	    if (fputs(empty, fp) < 0)
+	    if (ob_puts(ob, empty) < 0)
 		return -1;
 	
 	return 0;
     }
     
-    end = buf+strlen(buf);
+    end = tail = buf+len;
     if (p_strip)
     {
-	while (*buf && is_space(*buf))
-	    ++buf;
-	while (end > buf && is_space(end[-1]))
-	    --end;
+	while (buf < end && (n = sp_len(buf, end)) > 0)
+	    buf += n;
+	while (end > buf && (n = sp_len_back(buf, end)) > 0)
+	    end -= n;
     }
 	
-    if (strstr(buf, delim))
+    if (memmem(buf, tail-buf, delim, strlen(delim)))
 	quote = '"';
 
     if (quote)
-	if (putc(quote, fp) < 0)
+	if (ob_putc(ob, quote) < 0)
 	    return -1;
 
     if (buf == end)
     {
 	if (empty)
-	    if (fputs(empty, fp) < 0)
+	    if (ob_puts(ob, empty) < 0)
 		return -1;
 	
 	if (quote)
-	    if (putc(quote, fp) < 0)
+	    if (ob_putc(ob, quote) < 0)
 		return -1;
 	return 0;
     }
 
-    for (; *buf && buf < end; ++buf)
+    while (buf < end)
     {
-	if (p_strip > 1 && is_space(*buf) && is_space(lastc))
+	if (p_strip < 2 && out_charset == CS_UTF8)
+	{
+	    p = memchr(buf, '\n', end-buf);
+	    if (!p)
+		p = end;
+	    if (quote)
+	    {
+		q = memchr(buf, quote, p-buf);
+		if (q)
+		    p = q;
+	    }
+	    
+	    if (p > buf)
+	    {
+		if (ob_write(ob, buf, p-buf) < 0)
+		    return -1;
+		buf = p;
+		continue;
+	    }
+	}
+	
+	n = sp_len(buf, end);
+	if (p_strip > 1 && n > 0 && lastsp)
+	{
+	    buf += n;
 	    continue;
+	}
+	lastsp = (n > 0);
 	
-	if (*buf == quote)
-	    if (putc('\\', fp) < 0)
+	if (quote && *buf == quote)
+	    if (ob_putc(ob, '\\') < 0)
 		return -1;
 
 	if (*buf == '\n')
 	{
-	    if (putc('\\', fp) < 0)
+	    if (ob_putc(ob, '\\') < 0)
 		return -1;
 	    
-	    if (putc('n', fp) < 0)
+	    if (ob_putc(ob, 'n') < 0)
 		return -1;
 	}
+	else if (*buf & 0x80)
+	{
+	    n = utf8_decode(buf, end, &c);
+	    if (n == 0)
+	    {
+		n = 1;
+		c = '?';
+	    }
+	    
+	    if (out_charset == CS_UTF8)
+	    {
+		if (ob_write(ob, buf, n) < 0)
+		    return -1;
+	    }
+	    else
+	    {
+		c = cs_encode(c, out_charset);
+		if (ob_putc(ob, c < 0 ? '?' : c) < 0)
+		    return -1;
+	    }
+	    
+	    buf += n;
+	    continue;
+	}
 	else
-	    if (putc(*buf, fp) < 0)
+	    if (ob_putc(ob, *buf) < 0)
 		return -1;
 	
-	lastc = *buf;
+	++buf;
     }
     
     if (quote)
-	if (putc(quote, fp) < 0)
+	if (ob_putc(ob, quote) < 0)
 	    return -1;
 
     return 1;
 }
 
 
-int
-table_print_csv(TABLE *tp,
-		FILE *fp)
+/*
+** Copy the text of a cell with white space stripped (-s) and
+** collapsed (-ss) like puts_csv() does. Returns the new length.
+*/
+size_t
+text_strip(char *dst,
+	   const char *buf,
+	   size_t len)
 {
-    int nr, nc;
-    TABLEROW *rp;
-
+    const char *end = buf+len;
+    char *dp = dst;
+    int n, lastsp = 0;
 
-    if (!tp)
-	return 0; /* Nothing to print */
 
-    if (debug)
-	fprintf(stderr, "table_print_csv(tp->id=%d, tp->rc=%d, tp->cm=%d)\n",
-		tp->id, tp->rc, tp->cm);
-    
-    if (p_caption && tp->caption)
+    if (p_strip)
     {
-	if (!match)
-	{
-	    if (fprintf(fp, "%d%s", tp->id, delim) < 0)
-		return -1;
-	    
-	    if (p_rowno && fprintf(fp, "%d%s", 0, delim) < 0)
-		return -1;
-	}
-	else
-	    if (p_rowno && fprintf(fp, "%d%s", 0, delim) < 0)
-		return -1;
-	
-	if (puts_csv(tp->caption, fp) < 0)
-	    return -1;
-	
-	if (putc('\n', fp) < 0)
-	    return -1;
+	while (buf < end && (n = sp_len(buf, end)) > 0)
+	    buf += n;
+	while (end > buf && (n = sp_len_back(buf, end)) > 0)
+	    end -= n;
     }
-    
-    for (nr = 0; nr < tp->rc; nr++)
+
+    if (p_strip < 2)
     {
-	rp = tp->rv[nr];
+	memcpy(dp, buf, end-buf);
+	return end-buf;
+    }
 
-	if (!match)
+    while (buf < end)
+    {
+	n = sp_len(buf, end);
+	if (n > 0)
 	{
-	    if (fprintf(fp, "%d", tp->id) < 0)
-		return -1;
-	    
-	    if (p_rowno && fprintf(fp, "%s%d", delim, nr+1) < 0)
-		return -1;
+	    if (!lastsp)
+	    {
+		memcpy(dp, buf, n);
+		dp += n;
+	    }
+	    lastsp = 1;
+	    buf += n;
 	}
 	else
-	    if (p_rowno && fprintf(fp, "%d", nr+1) < 0)
-		return -1;
-
-	nc = 0;
-	if (rp)
 	{
-	    for (; nc <= rp->cm; nc++)
-	    {
-		if (!match || nc > 0 || p_rowno)
-		    if (fputs(delim, fp) < 0)
-			return -1;
-		
-		if (puts_csv(rp->cv[nc], fp) < 0)
-		    return -1;
-	    }
+	    lastsp = 0;
+	    *dp++ = *buf++;
 	}
-	
-	if (fill_out)
-	    for (; nc <= tp->cm; nc++)
-	    {
-		if (!match || nc > 0 || p_rowno)
-		{
-		    if (fputs(delim, fp) < 0)
-			return -1;
-		}
-		if (empty)
-		    if (fputs(empty, fp) < 0)
-			return -1;
-	    }
-	
-	if (putc('\n', fp) < 0)
-	    return -1;
     }
 
-    return 1;
+    return dp-dst;
 }
 
 
-
-void
-output(TABLE *tp,
-       char *buf,
-       int len,
-       int rowspan,
-       int colspan)
+/*
+** Apply -s and -ss to a cell for the output formats other than csv
+** (puts_csv() does it on the fly). With -ss the text is copied to a
+** malloc()ed buffer returned in *tmpp for the caller to free.
+*/
+int
+cell_strip(const char **bufp,
+	   size_t *lenp,
+	   char **tmpp)
 {
-    char *cp;
-    
-    
-    if (debug > 1)
-	fprintf(stderr, "output(tp->id=%d, tp->rc=%d, rowspan=%d, colspan=%d): '%.*s'\n",
-		tp->id, tp->rc, rowspan, colspan, len, buf);
+    const char *buf = *bufp, *end = buf + *lenp;
+    int n;
 
-    cp = ent_decode(buf, len);
-    if (!cp)
+
+    *tmpp = NULL;
+    if (!buf || !p_strip)
+	return 0;
+
+    if (p_strip > 1)
     {
-	if (debug > 1)
-	    fprintf(stderr, "   -> ent_decode() failed\n");
-	return;
-    }	
+	*tmpp = malloc(*lenp ? *lenp : 1);
+	if (!*tmpp)
+	    return -1;
 	
-    table_append(tp, cp, rowspan, colspan);
+	*lenp = text_strip(*tmpp, buf, *lenp);
+	*bufp = *tmpp;
+	return 0;
+    }
+
+    while (buf < end && (n = sp_len(buf, end)) > 0)
+	buf += n;
+    while (end > buf && (n = sp_len_back(buf, end)) > 0)
+	end -= n;
+
+    *bufp = buf;
+    *lenp = end-buf;
+    return 0;
 }
 
 
+/*
+** Print the (UTF-8) character at 'buf' in the output charset, '?' if
+** it can not be represented. Returns its length, or -1 on error.
+*/
 int
-is_tag(char *buf,
-       char *tag)
+put_char(OUTBUF *ob,
+	 const char *buf,
+	 const char *end)
 {
-    char *cp;
+    int c, n;
 
-    cp = buf;
-    if (*cp++ != '<')
-	return 0;
 
-    while (*tag && toupper(*cp) == *tag)
+    n = utf8_decode(buf, end, &c);
+    if (n == 0)
     {
-	++tag;
-	++cp;
+	n = 1;
+	c = '?';
     }
-    if (*tag)
-	return 0;
-    return (*cp == ' ' || *cp == '>');
+
+    if (out_charset == CS_UTF8)
+	return ob_write(ob, buf, n) < 0 ? -1 : n;
+
+    c = cs_encode(c, out_charset);
+    return ob_putc(ob, c < 0 ? '?' : c) < 0 ? -1 : n;
 }
 
 
-void *memmem(const void *haystack, size_t hlen, const void *needle, size_t nlen)
+/*
+** Print a cell as an RFC 4180 field: quoted if it contains the
+** delimiter, a quote or a line break, with quotes doubled.
+*/
+int
+puts_rfc4180(const char *buf,
+	     size_t len,
+	     OUTBUF *ob)
 {
-    int needle_first;
-    const void *p = haystack;
-    size_t plen = hlen;
-    
-    if (!nlen)
-	return NULL;
-    
-    needle_first = *(unsigned char *)needle;
+    const char *end, *p;
+    char *tmp;
+    int quote, n, rc = -1;
+    int flags = (out_charset == CS_UTF8 ? 0 : SCAN_HIGH);
+
+
+    if (cell_strip(&buf, &len, &tmp) < 0)
+	return -1;
     
-    while (plen >= nlen && (p = memchr(p, needle_first, plen - nlen + 1)))
+    if (!buf || len == 0)
     {
-	if (!memcmp(p, needle, nlen))
-	    return (void *)p;
-	
-	p++;
-	plen = hlen - (p - haystack);
+	rc = (empty ? ob_puts(ob, empty) : 0);
+	goto End;
     }
+
+    end = buf+len;
+    quote = (scan_esc(buf, end, "\"\r\n", 0) < end ||
+	     memmem(buf, len, delim, strlen(delim)) != NULL);
     
-    return NULL;
-}
+    if (quote && ob_putc(ob, '"') < 0)
+	goto End;
 
-int
-is_match(char *buf, int buflen, char *str)
-{
-    return memmem(buf, buflen, str, strlen(str)) != NULL;
+    while (buf < end)
+    {
+	p = scan_esc(buf, end, quote ? "\"" : "", flags);
+	if (p > buf)
+	{
+	    if (ob_write(ob, buf, p-buf) < 0)
+		goto End;
+	    buf = p;
+	    continue;
+	}
+
+	if (*buf == '"')
+	{
+	    if (ob_write(ob, "\"\"", 2) < 0)
+		goto End;
+	    ++buf;
+	}
+	else
+	{
+	    if ((n = put_char(ob, buf, end)) < 0)
+		goto End;
+	    buf += n;
+	}
+    }
+
+    if (quote && ob_putc(ob, '"') < 0)
+	goto End;
+    rc = 0;
+
+  End:
+    free(tmp);
+    return rc;
 }
 
 
-char *
-load_file(const char *path,
-	  size_t *buflen)
+/*
+** Print a cell as a TSV field, with tabs, line breaks and backslashes
+** escaped as \t, \n, \r and \\.
+*/
+int
+puts_tsv(const char *buf,
+	 size_t len,
+	 OUTBUF *ob)
 {
-    FILE *fp;
-    struct stat sb;
-    char *buf;
-    size_t bufsize, bufpos, to_read, got;
+    const char *end, *p, *esc;
+    char *tmp;
+    int n, rc = -1;
+    int flags = (out_charset == CS_UTF8 ? 0 : SCAN_HIGH);
 
 
-    bufsize = DEF_BUFSIZE;
+    if (cell_strip(&buf, &len, &tmp) < 0)
+	return -1;
     
-    if (path && strcmp(path, "-") != 0)
+    if (!buf || len == 0)
     {
-	fp = fopen(path, "r");
-	if (!fp)
-	    return NULL;
-	
-	if (fstat(fileno(fp), &sb) != 0)
-	{
-	    fclose(fp);
-	    return NULL;
-	}
-	
-	bufsize = sb.st_size + DEF_BUFSIZE;
+	rc = (empty ? ob_puts(ob, empty) : 0);
+	goto End;
     }
-    else
-	fp = stdin;
 
-    buf = malloc(bufsize+1);
-    if (!buf)
+    end = buf+len;
+    while (buf < end)
     {
-	if (fp != stdin)
-	    fclose(fp);
-	
-	return NULL;
-    }
+	p = scan_esc(buf, end, "\t\n\r\\", flags);
+	if (p > buf)
+	{
+	    if (ob_write(ob, buf, p-buf) < 0)
+		goto End;
+	    buf = p;
+	    continue;
+	}
 
-    *buflen = 0;
-    bufpos = 0;
-    do
-    {
-	if (bufpos >= bufsize)
+	switch (*buf)
 	{
-	    if (debug > 1)
-		fprintf(stderr, "read_file: realloc(bufsize=%lu+%lu), bufpos=%lu\n",
-			(unsigned long) bufsize, (unsigned long) DEF_BUFSIZE, (unsigned long) bufpos);
-	    
-	    bufsize += DEF_BUFSIZE;
-	    buf = realloc(buf, bufsize+1);
-	    if (!buf)
-	    {
-		if (fp != stdin)
-		    fclose(fp);
-		return NULL;
-	    }
+	  case '\t':
+	    esc = "\\t";
+	    break;
+	  case '\n':
+	    esc = "\\n";
+	    break;
+	  case '\r':
+	    esc = "\\r";
+	    break;
+	  case '\\':
+	    esc = "\\\\";
+	    break;
+	  default:
+	    esc = NULL;
 	}
-	
-	to_read = bufsize-bufpos;
-	got = fread(buf+bufpos, 1, to_read, fp);
-	if (debug > 1)
-	    fprintf(stderr, "read_file: fread(bufpos=%lu, to_read=%lu) -> got=%lu\n",
-		    (unsigned long) bufpos, (unsigned long) to_read, (unsigned long) got);
-	
-	if (got > 0)
+
+	if (esc)
+	{
+	    if (ob_write(ob, esc, 2) < 0)
+		goto End;
+	    ++buf;
+	}
+	else
 	{
-	    *buflen += got;
-	    bufpos += got;
+	    if ((n = put_char(ob, buf, end)) < 0)
+		goto End;
+	    buf += n;
 	}
-    } while (got == to_read);
+    }
+    rc = 0;
 
-    if (fp != stdin)
-	fclose(fp);
-    
-    buf[*buflen] = '\0';
-    return buf;
+  End:
+    free(tmp);
+    return rc;
 }
 
-void
-print_line(char *str,
-	   FILE *fp)
+
+/* Print a \uXXXX escape (as a surrogate pair above U+FFFF) */
+int
+put_uesc(OUTBUF *ob,
+	 int c)
 {
-    char *ep;
-    
-    ep = strchr(str, '\n');
-    if (ep)
-	fprintf(fp, "%.*s", (int) (ep-str), str);
-    else
-	fputs(str, fp);
-    putc('\n', fp);
-}
+    static const char hex[] = "0123456789abcdef";
+    char tmp[6];
+    int i;
 
 
-void
-print_version(FILE *fp)
-{
-    fprintf(fp, "[PHTX %s - Peter's HTML Table Extractor>]\n", version);
+    if (c > 0xFFFF)
+    {
+	c -= 0x10000;
+	if (put_uesc(ob, 0xD800 + (c >> 10)) < 0)
+	    return -1;
+	c = 0xDC00 + (c & 0x3FF);
+    }
+
+    tmp[0] = '\\';
+    tmp[1] = 'u';
+    for (i = 0; i < 4; i++)
+	tmp[2+i] = hex[(c >> (12-4*i)) & 0xF];
+
+    return ob_write(ob, tmp, 6);
 }
 
-int
-main(int argc,
+
+/*
+** Print a cell as a JSON string. Characters outside ASCII are printed
+** as \u escapes unless the output charset is UTF-8.
+*/
+int
+puts_json(const char *buf,
+	  size_t len,
+	  OUTBUF *ob)
+{
+    const char *end, *p, *esc;
+    char *tmp;
+    int c, n, rc = -1;
+    int flags = SCAN_CTL | (out_charset == CS_UTF8 ? 0 : SCAN_HIGH);
+
+
+    if (cell_strip(&buf, &len, &tmp) < 0)
+	return -1;
+    
+    if (!buf || len == 0)
+    {
+	buf = (empty ? empty : "");
+	len = strlen(buf);
+    }
+
+    if (ob_putc(ob, '"') < 0)
+	goto End;
+    
+    end = buf+len;
+    while (buf < end)
+    {
+	p = scan_esc(buf, end, "\"\\", flags);
+	if (p > buf)
+	{
+	    if (ob_write(ob, buf, p-buf) < 0)
+		goto End;
+	    buf = p;
+	    continue;
+	}
+
+	switch (*buf)
+	{
+	  case '"':
+	    esc = "\\\"";
+	    break;
+	  case '\\':
+	    esc = "\\\\";
+	    break;
+	  case '\n':
+	    esc = "\\n";
+	    break;
+	  case '\r':
+	    esc = "\\r";
+	    break;
+	  case '\t':
+	    esc = "\\t";
+	    break;
+	  default:
+	    esc = NULL;
+	}
+
+	if (esc)
+	{
+	    if (ob_write(ob, esc, 2) < 0)
+		goto End;
+	    ++buf;
+	    continue;
+	}
+
+	n = utf8_decode(buf, end, &c);
+	if (n == 0)
+	{
+	    n = 1;
+	    c = 0xFFFD;
+	}
+
+	if (c >= 0x20 && out_charset == CS_UTF8)
+	{
+	    if (ob_write(ob, buf, n) < 0)
+		goto End;
+	}
+	else if (put_uesc(ob, c) < 0)
+	    goto End;
+	buf += n;
+    }
+
+    if (ob_putc(ob, '"') < 0)
+	goto End;
+    rc = 0;
+
+  End:
+    free(tmp);
+    return rc;
+}
+
+
+/* Print a cell in the selected (text) output format */
+int
+puts_cell(const char *buf,
+	  size_t len,
+	  OUTBUF *ob)
+{
+    switch (out_format)
+    {
+      case FMT_RFC4180:
+	return puts_rfc4180(buf, len, ob);
+      case FMT_TSV:
+	return puts_tsv(buf, len, ob);
+      case FMT_JSONL:
+	return puts_json(buf, len, ob);
+    }
+
+    return puts_csv(buf, len, ob);
+}
+
+
+/*
+** Print what an output line starts with: the table id (unless -M
+** selects a single table), for jsonl as the first member of the object.
+*/
+int
+put_lead(OUTBUF *ob,
+	 int id)
+{
+    if (out_format == FMT_JSONL)
+    {
+	if (ob_putc(ob, '{') < 0)
+	    return -1;
+	if (!m_one && (ob_puts(ob, "\"table\":") < 0 || ob_putint(ob, id) < 0))
+	    return -1;
+	return 0;
+    }
+
+    if (!m_one)
+	return ob_putint(ob, id);
+
+    return 0;
+}
+
+
+/*
+** Start an output line of table 'tp'. Normally that is just the table
+** id (see m_one). -j workers instead record where the line
+** starts and which (file local) table it belongs to, and the ids are
+** filled in when the outputs of all files are put together.
+*/
+int
+print_id(PARSER *pp,
+	 TABLE *tp,
+	 OUTBUF *ob)
+{
+    if (pp->tagged)
+    {
+	if (pp->lc >= pp->ls)
+	{
+	    LINEREC *nlv;
+	    int ns = pp->ls ? pp->ls*2 : DEF_ROWS;
+
+	    nlv = realloc(pp->lv, sizeof(pp->lv[0])*ns);
+	    if (!nlv)
+		return -1;
+	    
+	    pp->lv = nlv;
+	    pp->ls = ns;
+	}
+	
+	pp->lv[pp->lc].pos = ob_pos(ob);
+	pp->lv[pp->lc].id = tp->id;
+	++pp->lc;
+	return 0;
+    }
+
+    return put_lead(ob, tp->id);
+}
+
+
+int
+table_print_csv(PARSER *pp,
+		TABLE *tp,
+		OUTBUF *ob)
+{
+    int nr, nc, k;
+    TABLEROW *rp;
+
+
+    if (!tp)
+	return 0; /* Nothing to print */
+
+    if (debug)
+	fprintf(stderr, "table_print_csv(tp->id=%d, tp->rc=%d, tp->cm=%d)\n",
+		tp->id, tp->rc, tp->cm);
+    
+    if (p_caption && (tp->caption.len & CELL_SET))
+    {
+	if (print_id(pp, tp, ob) < 0)
+	    return -1;
+	
+	if (!m_one)
+	{
+	    if (ob_puts(ob, delim) < 0)
+		return -1;
+	    
+	    if (p_rowno && (ob_putc(ob, '0') < 0 || ob_puts(ob, delim) < 0))
+		return -1;
+	}
+	else
+	    if (p_rowno && (ob_putc(ob, '0') < 0 || ob_puts(ob, delim) < 0))
+		return -1;
+	
+	if (puts_cell(CELL_TEXT(tp, tp->caption), CELL_LEN(tp->caption), ob) < 0)
+	    return -1;
+	
+	if (ob_puts(ob, eol) < 0)
+	    return -1;
+    }
+    
+    for (nr = row_first; nr < tp->rc && nr <= row_last; nr++)
+    {
+	rp = &tp->rv[nr];
+
+	if (print_id(pp, tp, ob) < 0)
+	    return -1;
+	
+	if (!m_one)
+	{
+	    if (p_rowno && (ob_puts(ob, delim) < 0 || ob_putint(ob, nr+1) < 0))
+		return -1;
+	}
+	else
+	    if (p_rowno && ob_putint(ob, nr+1) < 0)
+		return -1;
+
+	nc = col_next(0);
+	k = 0;
+	if (rp->cv)
+	{
+	    for (; nc <= rp->cm; nc = col_next(nc+1), k++)
+	    {
+		if (!m_one || k > 0 || p_rowno)
+		    if (ob_puts(ob, delim) < 0)
+			return -1;
+		
+		if (puts_cell(CELL_TEXT(tp, rp->cv[nc]), CELL_LEN(rp->cv[nc]), ob) < 0)
+		    return -1;
+	    }
+	}
+	
+	if (fill_out)
+	    for (; nc <= tp->cm; nc = col_next(nc+1), k++)
+	    {
+		if (!m_one || k > 0 || p_rowno)
+		{
+		    if (ob_puts(ob, delim) < 0)
+			return -1;
+		}
+		if (empty)
+		    if (ob_puts(ob, empty) < 0)
+			return -1;
+	    }
+	
+	if (ob_puts(ob, eol) < 0)
+	    return -1;
+    }
+
+    return 1;
+}
+
+
+/*
+** Print a table as JSON Lines, one object per row with the table id
+** (see m_one), the row number (-r) and an array of the cells.
+** The caption (-c) gets an object of its own.
+*/
+int
+table_print_json(PARSER *pp,
+		 TABLE *tp,
+		 OUTBUF *ob)
+{
+    int nr, nc, k;
+    const char *sep;
+    TABLEROW *rp;
+
+
+    if (!tp)
+	return 0; /* Nothing to print */
+
+    if (debug)
+	fprintf(stderr, "table_print_json(tp->id=%d, tp->rc=%d, tp->cm=%d)\n",
+		tp->id, tp->rc, tp->cm);
+    
+    sep = (m_one ? "" : ",");
+    
+    if (p_caption && (tp->caption.len & CELL_SET))
+    {
+	if (print_id(pp, tp, ob) < 0 ||
+	    ob_puts(ob, sep) < 0 ||
+	    ob_puts(ob, "\"caption\":") < 0 ||
+	    puts_json(CELL_TEXT(tp, tp->caption), CELL_LEN(tp->caption), ob) < 0 ||
+	    ob_puts(ob, "}\n") < 0)
+	    return -1;
+    }
+
+    for (nr = row_first; nr < tp->rc && nr <= row_last; nr++)
+    {
+	rp = &tp->rv[nr];
+
+	if (print_id(pp, tp, ob) < 0 || ob_puts(ob, sep) < 0)
+	    return -1;
+
+	if (p_rowno &&
+	    (ob_puts(ob, "\"row\":") < 0 || ob_putint(ob, nr+1) < 0 || ob_putc(ob, ',') < 0))
+	    return -1;
+
+	if (ob_puts(ob, "\"cells\":[") < 0)
+	    return -1;
+	
+	nc = col_next(0);
+	k = 0;
+	if (rp->cv)
+	{
+	    for (; nc <= rp->cm; nc = col_next(nc+1), k++)
+	    {
+		if (k > 0 && ob_putc(ob, ',') < 0)
+		    return -1;
+		
+		if (puts_json(CELL_TEXT(tp, rp->cv[nc]), CELL_LEN(rp->cv[nc]), ob) < 0)
+		    return -1;
+	    }
+	}
+	
+	if (fill_out)
+	    for (; nc <= tp->cm; nc = col_next(nc+1), k++)
+	    {
+		if (k > 0 && ob_putc(ob, ',') < 0)
+		    return -1;
+		
+		if (puts_json(NULL, 0, ob) < 0)
+		    return -1;
+	    }
+	
+	if (ob_puts(ob, "]}\n") < 0)
+	    return -1;
+    }
+
+    return 1;
+}
+
+
+/* Remember where a worker wrote the table ids of an Arrow batch */
+int
+add_idpatch(PARSER *pp,
+	    size_t pos,
+	    int n)
+{
+    if (pp->pc >= pp->ps)
+    {
+	IDPATCH *npv;
+	int ns = pp->ps ? pp->ps*2 : DEF_TABLES;
+
+	npv = realloc(pp->pv, sizeof(pp->pv[0])*ns);
+	if (!npv)
+	    return -1;
+
+	pp->pv = npv;
+	pp->ps = ns;
+    }
+
+    pp->pv[pp->pc].pos = pos;
+    pp->pv[pp->pc].n = n;
+    ++pp->pc;
+    return 0;
+}
+
+
+/*
+** Print a table as an Arrow IPC stream. The columns are the table id
+** (see m_one) and the row number (-r) as int32, then one utf8
+** column per table column. Empty and missing cells, and cells filled
+** by a row/colspan (unless -R), are null. The caption (-c) is stored
+** as schema metadata.
+*/
+int
+table_print_arrow(PARSER *pp,
+		  TABLE *tp,
+		  OUTBUF *ob)
+{
+    ARROW_BATCH ab;
+    char *names, *dp;
+    size_t pos, len;
+    int ni, nc, nr, c, n, *colv, rc = -1;
+    CELL *cp;
+    TABLEROW *rp;
+
+
+    if (!tp)
+	return 0;
+
+    if (debug)
+	fprintf(stderr, "table_print_arrow(tp->id=%d, tp->rc=%d, tp->cm=%d)\n",
+		tp->id, tp->rc, tp->cm);
+
+    /* Like the CSV output, a table without (selected) rows prints nothing */
+    if (tp->rc <= row_first && !(p_caption && (tp->caption.len & CELL_SET)))
+	return 0;
+    
+    if (pp->tagged && print_id(pp, tp, ob) < 0)
+	return -1;
+
+    /* Table columns to print: those that exist in some row and -C selects */
+    for (c = -1, nr = 0; nr < tp->rc; nr++)
+	if (tp->rv[nr].cv && tp->rv[nr].cm > c)
+	    c = tp->rv[nr].cm;
+    
+    colv = malloc((c+2)*sizeof(int));
+    if (!colv)
+	return -1;
+    
+    nc = 0;
+    for (n = c, c = col_next(0); c <= n; c = col_next(c+1))
+	colv[nc++] = c;
+    
+    ni = (!m_one) + (p_rowno != 0);
+    nc += ni;
+    names = malloc((nc ? nc : 1)*16);
+    if (!names || arrow_init(&ab, nc) < 0)
+    {
+	free(names);
+	free(colv);
+	return -1;
+    }
+
+    c = 0;
+    if (!m_one)
+    {
+	ab.cv[c].name = "table";
+	ab.cv[c++].type = ARROW_INT32;
+    }
+    if (p_rowno)
+    {
+	ab.cv[c].name = "row";
+	ab.cv[c++].type = ARROW_INT32;
+    }
+    for (; c < nc; c++)
+    {
+	sprintf(names+c*16, "c%d", colv[c-ni]+1);
+	ab.cv[c].name = names+c*16;
+	ab.cv[c].type = ARROW_UTF8;
+    }
+
+    if (p_caption && (tp->caption.len & CELL_SET))
+    {
+	if (arrow_schema(&ab, ob, "caption", CELL_TEXT(tp, tp->caption), CELL_LEN(tp->caption)) < 0)
+	    goto End;
+    }
+    else if (arrow_schema(&ab, ob, NULL, NULL, 0) < 0)
+	goto End;
+
+    /* Without any columns there is nothing to hold the rows */
+    for (nr = row_first; nc > 0 && nr < tp->rc && nr <= row_last; nr++)
+    {
+	rp = &tp->rv[nr];
+
+	c = 0;
+	if (!m_one && arrow_add_int(&ab, c++, tp->id) < 0)
+	    goto End;
+	if (p_rowno && arrow_add_int(&ab, c++, nr+1) < 0)
+	    goto End;
+
+	for (; c < nc; c++)
+	{
+	    cp = (rp->cv && colv[c-ni] <= rp->cm) ? &rp->cv[colv[c-ni]] : NULL;
+	    len = cp ? CELL_LEN(*cp) : 0;
+	    if (len > 0)
+	    {
+		dp = arrow_str_reserve(&ab, c, len);
+		if (!dp)
+		    goto End;
+		len = text_strip(dp, CELL_TEXT(tp, *cp), len);
+	    }
+
+	    if (len > 0 ? arrow_str_commit(&ab, c, len) < 0 : arrow_add_null(&ab, c) < 0)
+		goto End;
+	}
+
+	n = ab.cv[0].n;
+	if (n >= ARROW_ROWS || nr+1 == tp->rc || nr == row_last)
+	{
+	    if (arrow_batch(&ab, ob, &pos) < 0)
+		goto End;
+
+	    if (pp->tagged && !m_one && add_idpatch(pp, pos, n) < 0)
+		goto End;
+	}
+    }
+
+    rc = arrow_eos(ob);
+
+  End:
+    arrow_free(&ab);
+    free(names);
+    free(colv);
+    return rc;
+}
+
+
+/*
+** Print (subject to the -M selector) and release all pending tables.
+** Called whenever the outermost open table is closed, so memory use
+** is bounded by the largest top-level table instead of the whole input.
+** -j workers print all tables, the selection is done when merging.
+** The output is only flushed here when reading from a stream (so the
+** output keeps up with the input), else when the buffer is full.
+*/
+int
+table_flush(PARSER *pp)
+{
+    int ti, rc = 0;
+    ST_CLOCK t;
+
+
+    if (debug)
+	fprintf(stderr, "table_flush(): tc=%d\n", pp->tc);
+
+    /* Often called for small tables, so only the wall clock is used */
+    if (stats)
+	st_start(&pp->st, &t, 0);
+
+    for (ti = 0; ti < pp->tc; ti++)
+    {
+	if (rc == 0 && !pp->tv[ti]->skip && !pp->tv[ti]->pend)
+	    if ((out_format == FMT_ARROW ? table_print_arrow(pp, pp->tv[ti], pp->out) :
+		 out_format == FMT_JSONL ? table_print_json(pp, pp->tv[ti], pp->out) :
+		 table_print_csv(pp, pp->tv[ti], pp->out)) < 0)
+		rc = -1;
+
+	table_free(pp, pp->tv[ti]);
+	pp->tv[ti] = NULL;
+    }
+    pp->tc = 0;
+
+    if (rc == 0 && !pp->base && ob_flush(pp->out) < 0)
+	rc = -1;
+
+    if (stats)
+	st_stop(&pp->st, &t, ST_EMIT);
+    
+    return rc;
+}
+
+
+
+/*
+** Make room for 'len' more bytes in the table string pool.
+*/
+int
+pool_reserve(TABLE *tp,
+	     size_t len)
+{
+    size_t need = tp->pool_len + len;
+    size_t ns;
+    char *npool;
+
+
+    if (need <= tp->pool_size)
+	return 0;
+    
+    /* Offsets are 32 bits */
+    if (need > 0xFFFFFFFFUL)
+	return -1;
+    
+    ns = tp->pool_size ? tp->pool_size*2 : DEF_POOL;
+    while (ns < need)
+	ns *= 2;
+    if (ns > 0xFFFFFFFFUL)
+	ns = 0xFFFFFFFFUL;
+    
+    npool = realloc(tp->pool, ns);
+    if (!npool)
+	return -1;
+    
+    tp->pool = npool;
+    tp->pool_size = ns;
+    tp->pool_allocs++;
+    return 0;
+}
+
+
+/*
+** Decode the entities in 'len' bytes of cell text straight into the
+** table string pool, and describe the result in *cp. The holes of the
+** open cell are decoded as a blank for every byte, as the tags used to
+** be blanked in the input buffer, or with -b as a single blank so the
+** text does not grow with what is nested in the cell. The number of
+** entities decoded is added to *nrefs.
+*/
+int
+table_text(TABLE *tp,
+	   const char *buf,
+	   int len,
+	   int charset,
+	   CELL *cp,
+	   int *nrefs)
+{
+    size_t off, hl;
+    char *dp;
+    int i, n;
+
+
+    if (pool_reserve(tp, (size_t) len*3+1) < 0)
+	return -1;
+
+    dp = tp->pool+tp->pool_len;
+    n = 0;
+    off = 0;
+    if (buf == tp->td_s)
+	for (i = 0; i < tp->hc && tp->hv[i].off < (size_t) len; i++)
+	{
+	    if (tp->hv[i].off < off)
+		continue;
+	    
+	    n += ent_decode_buf(dp+n, buf+off, tp->hv[i].off-off, charset, nrefs);
+	    
+	    hl = tp->hv[i].len;
+	    if (hl > (size_t) len - tp->hv[i].off)
+		hl = len - tp->hv[i].off;
+	    off = tp->hv[i].off + hl;
+	    if (p_squeeze)
+		hl = 1;
+	    memset(dp+n, ' ', hl);
+	    n += hl;
+	}
+    n += ent_decode_buf(dp+n, buf+off, len-off, charset, nrefs);
+    if ((size_t) n > CELL_LENMASK)
+	return -1;
+    
+    cp->off = tp->pool_len;
+    cp->len = n | CELL_SET;
+    tp->pool_len += n;
+    return 0;
+}
+
+
+/*
+** Copy the text of all cells that still point into the input buffer
+** into the table string pool. Must be done before the buffer is
+** unmapped. Referencing the input only saves memory as long as the
+** mapping is never written to, as a written page is copied and stays
+** resident anyway.
+*/
+int
+table_pin(TABLE *tp)
+{
+    int i, j;
+    CELL *cp;
+    
+
+    if (!tp->src)
+	return 0;
+    
+    if (debug)
+	fprintf(stderr, "table_pin(tp->id=%d)\n", tp->id);
+    
+    /* The caption (row -1), then the rows, then the rowspans (row rs) */
+    for (i = -1; i <= tp->rs; i++)
+    {
+	if (i >= 0 && i < tp->rs && tp->rv[i].cv == NULL)
+	    continue;
+	
+	for (j = 0; j < (i < 0 ? 1 : i < tp->rs ? tp->rv[i].cs : tp->sc); j++)
+	{
+	    cp = (i < 0 ? &tp->caption : i < tp->rs ? &tp->rv[i].cv[j] : &tp->sv[j].text);
+	    if (!(cp->len & CELL_REF))
+		continue;
+
+	    if (pool_reserve(tp, CELL_LEN(*cp)) < 0)
+		return -1;
+	    
+	    if (CELL_LEN(*cp) > 0)
+		memcpy(tp->pool+tp->pool_len, tp->src+cp->off, CELL_LEN(*cp));
+	    cp->off = tp->pool_len;
+	    cp->len &= ~CELL_REF;
+	    tp->pool_len += CELL_LEN(*cp);
+	}
+    }
+
+    tp->src = NULL;
+    return 0;
+}
+
+
+/*
+** Store the text of a cell. Text that needs no decoding (no entities,
+** no holes and already valid UTF-8) is referenced in the input buffer
+** where possible instead of being copied.
+*/
+int
+cell_text(PARSER *pp,
+	  TABLE *tp,
+	  const char *buf,
+	  int len,
+	  CELL *cp)
+{
+    ST_CLOCK t;
+    int rc, nrefs = 0;
+
+    
+    if (pp->base && buf >= pp->base && buf+len <= pp->base+pp->size &&
+	buf-pp->base <= 0xFFFFFFFFL && (size_t) len <= CELL_LENMASK &&
+	(!tp->src || tp->src == pp->base) &&
+	(buf != tp->td_s || tp->hc == 0) &&
+	!memchr(buf, '&', len) && cs_unchanged(buf, len, pp->charset))
+    {
+	tp->src = pp->base;
+	cp->off = buf-pp->base;
+	cp->len = len | CELL_SET | CELL_REF;
+	return 0;
+    }
+    
+    if (stats)
+	st_start(&pp->st, &t, 0);
+    rc = table_text(tp, buf, len, pp->charset, cp, &nrefs);
+    if (stats)
+	st_stop(&pp->st, &t, ST_DECODE);
+    
+    pp->st.entities += nrefs;
+    return rc;
+}
+
+
+/*
+** Does the cell with the text 'cp' (NULL if not needed) that ends at
+** the current position satisfy the row and cell part of -M?
+*/
+int
+cell_selected(TABLE *tp,
+	      const CELL *cp)
+{
+    if ((sel->row && tp->rc+1 != sel->row) || (sel->col && tp->nc != sel->col))
+	return 0;
+
+    return !sel->cell || sel_text(sel->cell, CELL_TEXT(tp, *cp), CELL_LEN(*cp));
+}
+
+
+void
+output(PARSER *pp,
+       TABLE *tp,
+       char *buf,
+       int len,
+       int rowspan,
+       int colspan)
+{
+    CELL text;
+    int cc, have = 0;
+    
+    
+    if (tp->skip)
+	return;
+
+    if (tp->pend & PEND_CELLS)
+    {
+	/* Decoded for -M, even if not stored */
+	if (sel->cell)
+	{
+	    if (cell_text(pp, tp, buf, len, &text) < 0)
+		return;
+	    have = 1;
+	}
+	
+	if (cell_selected(tp, &text))
+	    tp->pend &= ~PEND_CELLS;
+    }
+    
+    if (tp->rc > row_last)
+	return;
+    
+    if (debug > 1)
+	fprintf(stderr, "output(tp->id=%d, tp->rc=%d, rowspan=%d, colspan=%d): '%.*s'\n",
+		tp->id, tp->rc, rowspan, colspan, len, buf);
+
+    if (projecting)
+    {
+	/*
+	** Cells outside the projection only keep their place in the
+	** table (without text). Right of all selected columns one such
+	** cell per row is enough (for -f), the rest are dropped unless
+	** they fill rows below.
+	*/
+	cc = table_next_cell(tp);
+	if (cc < 0 ||
+	    (col_map && col_from == INT_MAX && cc > col_max &&
+	     tp->rv[tp->rc].cm > col_max && rowspan < 2))
+	    return;
+	
+	if (!cell_wanted(tp->rc, cc, rowspan, colspan))
+	{
+	    text.off = 0;
+	    text.len = CELL_SET;
+	    goto Append;
+	}
+    }
+
+    if (!have && cell_text(pp, tp, buf, len, &text) < 0)
+    {
+	if (debug > 1)
+	    fprintf(stderr, "   -> cell_text() failed\n");
+	return;
+    }	
+
+  Append:
+    if (table_append(tp, &text, rowspan, colspan) >= 0)
+	pp->st.cells++;
+}
+
+
+/* Pack up to 8 (upper case) tag name characters into a switch key */
+#define TK(a,b,c,d,e,f,g,h) \
+    (((unsigned long long) (a) << 56) | ((unsigned long long) (b) << 48) | \
+     ((unsigned long long) (c) << 40) | ((unsigned long long) (d) << 32) | \
+     ((unsigned long long) (e) << 24) | ((unsigned long long) (f) << 16) | \
+     ((unsigned long long) (g) <<  8) |  (unsigned long long) (h))
+
+/*
+** Classify the tag starting at 'buf' (pointing at the '<'). The name
+** (including a leading '/') is read once, upper cased into a packed key
+** and looked up in a single switch. A name must be followed by white
+** space or '>' to count.
+*/
+int
+tag_class(const char *buf)
+{
+    const char *cp = buf+1;
+    unsigned long long key = 0;
+    int len;
+
+
+    for (len = 0; cp[len] != '>' && !isspace((unsigned char) cp[len]); len++)
+    {
+	if (len == 8 || cp[len] == '\0')
+	    return TAG_OTHER;
+	
+	key = (key << 8) | (unsigned char) toupper((unsigned char) cp[len]);
+    }
+    
+    /* Left align the key so it can be compared with TK() constants */
+    if (len == 0)
+	return TAG_OTHER;
+    key <<= 8*(8-len);
+
+    switch (key)
+    {
+      case TK('I','M','G',0,0,0,0,0):
+	return TAG_IMG;
+      case TK('T','A','B','L','E',0,0,0):
+	return TAG_TABLE;
+      case TK('/','T','A','B','L','E',0,0):
+	return TAG_TABLE_END;
+      case TK('T','R',0,0,0,0,0,0):
+	return TAG_TR;
+      case TK('/','T','R',0,0,0,0,0):
+	return TAG_TR_END;
+      case TK('C','A','P','T','I','O','N',0):
+	return TAG_CAPTION;
+      case TK('/','C','A','P','T','I','O','N'):
+	return TAG_CAPTION_END;
+      case TK('T','D',0,0,0,0,0,0):
+	return TAG_TD;
+      case TK('/','T','D',0,0,0,0,0):
+	return TAG_TD_END;
+      case TK('T','H',0,0,0,0,0,0):
+	return TAG_TH;
+      case TK('/','T','H',0,0,0,0,0):
+	return TAG_TH_END;
+      case TK('S','C','R','I','P','T',0,0):
+	return TAG_SCRIPT;
+      case TK('S','T','Y','L','E',0,0,0):
+	return TAG_STYLE;
+    }
+
+    return TAG_OTHER;
+}
+
+
+/*
+** Get the rowspan and colspan of the TD or TH tag at 'buf' ('end' at
+** the '>'). Values that are not numbers count as 1, and too big ones
+** are cut down to the limits of HTML. A rowspan of 0 (to the end of the
+** row group) is not supported and counts as 1 too.
+*/
+void
+cell_spans(const char *buf,
+	   const char *end,
+	   int *rowspan,
+	   int *colspan)
+{
+    const char *cp;
+    ATTR ab;
+    int rs = -1, cs = -1;
+
+    
+    cp = attr_start(buf, end);
+    while ((rs < 0 || cs < 0) && (cp = attr_next(cp, end, &ab)) != NULL)
+    {
+	/* The first one wins */
+	if (rs < 0 && attr_is(&ab, "rowspan"))
+	    rs = attr_int(&ab, 1);
+	else if (cs < 0 && attr_is(&ab, "colspan"))
+	    cs = attr_int(&ab, 1);
+    }
+
+    *rowspan = (rs < 1 ? 1 : rs > MAX_ROWSPAN ? MAX_ROWSPAN : rs);
+    *colspan = (cs < 1 ? 1 : cs > MAX_COLSPAN ? MAX_COLSPAN : cs);
+}
+
+
+int
+is_match(char *buf, int buflen, char *str)
+{
+    return memmem(buf, buflen, str, strlen(str)) != NULL;
+}
+
+
+/*
+** Size of the mapping used for a file of 'len' bytes. Always includes
+** at least one extra (zero-filled) byte so the buffer is NUL terminated.
+*/
+size_t
+map_size(size_t len)
+{
+    size_t pagesize = (size_t) sysconf(_SC_PAGESIZE);
+
+    return (len + pagesize) & ~(pagesize-1);
+}
+
+
+/*
+** Map a regular file into memory, read-only. The file is mapped on top
+** of an anonymous reservation one byte larger than the file, so the
+** byte after the data is guaranteed to be zero even if the file size
+** is an exact multiple of the page size.
+*/
+char *
+map_file(int fd,
+	 size_t len)
+{
+    char *buf;
+    size_t maplen;
+
+
+    maplen = map_size(len);
+    
+    buf = mmap(NULL, maplen, PROT_READ, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (buf == MAP_FAILED)
+	return NULL;
+
+    if (mmap(buf, len, PROT_READ, MAP_PRIVATE|MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+	munmap(buf, maplen);
+	return NULL;
+    }
+
+#ifdef MADV_SEQUENTIAL
+    (void) madvise(buf, len, MADV_SEQUENTIAL);
+#endif
+#ifdef POSIX_FADV_SEQUENTIAL
+    (void) posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    
+    if (debug > 1)
+	fprintf(stderr, "map_file: mapped %lu bytes at %p\n", (unsigned long) len, buf);
+    
+    return buf;
+}
+
+
+/*
+** Give the pages of the mapped input before 'end' back once no table
+** needs them (in steps of MAP_RELEASE bytes). The mapping is read-only,
+** so the pages are clean and this only shrinks the resident set -
+** anything still pointing there just reads the file again.
+*/
+void
+map_release(PARSER *pp,
+	    const char *end)
+{
+    size_t pagesize = (size_t) sysconf(_SC_PAGESIZE);
+    size_t a, b;
+
+
+    if (!pp->base || !pp->kept || end < pp->kept+MAP_RELEASE)
+	return;
+
+    /* The mapping starts on a page boundary */
+    a = (pp->kept-pp->base + pagesize-1) & ~(pagesize-1);
+    b = (end-pp->base) & ~(pagesize-1);
+    if (b <= a)
+	return;
+    
+#ifdef MADV_DONTNEED
+    (void) madvise((void *) (pp->base+a), b-a, MADV_DONTNEED);
+#endif
+    pp->kept = pp->base+b;
+}
+
+void
+print_line(char *str,
+	   FILE *fp)
+{
+    char *ep;
+    
+    ep = strchr(str, '\n');
+    if (ep)
+	fprintf(fp, "%.*s", (int) (ep-str), str);
+    else
+	fputs(str, fp);
+    putc('\n', fp);
+}
+
+
+/*
+** Find the end of the raw text of parser state 'state' (a comment,
+** script, style or CDATA section) starting at 'cp'. Nothing in raw
+** text is parsed, the terminator is found with scan_pair(). Returns
+** the position of its final '>', or NULL if it is not in [cp, end).
+** Then *rpp is set to where the search should continue when more data
+** is available (or 'end' at end of file). The newlines before the
+** returned position (or *rpp) are added to *nlp.
+*/
+char *
+raw_end(int state,
+	char *cp,
+	char *end,
+	int eof,
+	char **rpp,
+	int *nlp)
+{
+    static const char *terms[] = { "--", "</script", "</style", "]]" };
+    const char *term = terms[state-PS_COMMENT];
+    size_t tlen = strlen(term);
+    char *xp;
+    int nl;
+
+
+    for (;; ++cp)
+    {
+	cp = (char *) scan_pair(cp, end, term[0], term[1], nlp);
+	if (cp >= end)
+	{
+	    /* The last byte may start the terminator */
+	    *rpp = (!eof && end[-1] == term[0]) ? end-1 : end;
+	    return NULL;
+	}
+
+	if ((size_t) (end-cp) <= tlen)
+	{
+	    if (eof)
+		continue;
+	    
+	    *rpp = cp;
+	    return NULL;
+	}
+
+	if (tlen == 2)
+	{
+	    /* "-->" or "]]>" */
+	    if (cp[2] == '>')
+		return cp+2;
+	    continue;
+	}
+
+	/* An end tag, then the '>' after its (ignored) attributes */
+	if (strncasecmp(cp, term, tlen) != 0 || !cp[tlen] || !strchr(" \t\n\r\f/>", cp[tlen]))
+	    continue;
+
+	nl = 0;
+	xp = (char *) scan_chr(cp+tlen, end, '>', &nl);
+	if (xp < end)
+	{
+	    *nlp += nl;
+	    return xp;
+	}
+	
+	*rpp = (eof ? end : cp);
+	if (eof)
+	    *nlp += nl;
+	return NULL;
+    }
+}
+
+
+/*
+** Parse (part of) an input buffer. Parsing starts at 'start' and stops
+** at 'end', or a few bytes before it if more data is to follow (so the
+** tag lookahead never runs past the data we have). All state needed
+** to resume is kept in 'pp' and in the open tables. Returns the
+** position where parsing should continue with the next chunk.
+*/
+char *
+parse_buf(PARSER *pp,
+	  char *start,
+	  char *end,
+	  int eof)
+{
+    char *cp, *sp, *limit, *xp, *rp;
+    int state, lastc, line, tag, nl, hit;
+    TABLE *tp, *ntp;
+    int rowspan, colspan, skip_cell;
+    ST_CLOCK t;
+
+
+    if (stats)
+	st_start(&pp->st, &t, 1);
+    
+    if (eof)
+	limit = end;
+    else
+	limit = (end-start > LOOKAHEAD) ? end-LOOKAHEAD : start;
+    
+    state = pp->state;
+    sp = pp->sp;
+    lastc = pp->lastc;
+    line = pp->line;
+    tp = pp->tp;
+    rowspan = pp->rowspan;
+    colspan = pp->colspan;
+    skip_cell = pp->skip_cell;
+
+    for (cp = start; cp < limit && !pp->done; lastc = *cp, ++cp)
+    {
+	if (lastc == -1 || lastc == '\n')
+	{
+	    ++line;
+	    if (verbose > 1 || debug)
+	    {
+		fprintf(stderr, "%s#%u: >> ", pp->path, line);
+		print_line(cp, stderr);
+	    }
+	}
+
+	if (state >= PS_COMMENT)
+	{
+	    /* Skip to the end of raw text in one go (also see above) */
+	    nl = 0;
+	    xp = raw_end(state, cp, end, eof, &rp, &nl);
+	    line += nl;
+	    if (!xp)
+	    {
+		/* Continue with the next chunk */
+		if (rp > cp)
+		    lastc = rp[-1];
+		cp = rp;
+		line -= (lastc == '\n');
+
+		/* The start is only needed for a hole in the open cell */
+		if (!tp || !tp->td_s || sp < tp->td_s)
+		    sp = cp;
+		break;
+	    }
+
+	    if (tp && table_hole(tp, sp, xp) < 0)
+	    {
+		fprintf(stderr, "%s: %s#%u: Out of memory\n", argv0, pp->path, line);
+		exit(1);
+	    }
+	    if (state == PS_COMMENT)
+		pp->st.tags[TAG_COMMENT]++;
+	    else if (state == PS_CDATA)
+		pp->st.tags[TAG_CDATA]++;
+
+	    if (debug > 1)
+		fprintf(stderr, "raw: %.*s\n", (int) (xp-sp+1), sp);
+	    
+	    cp = xp;
+	    lastc = cp[-1];
+	    state = PS_TEXT;
+	    continue;
+	}
+	
+	/*
+	** Jump straight to the next '<' (in text) or '>' (in tags) -
+	** nothing else affects the parser state. Lines are counted on
+	** the way, unless we need to print each of them.
+	*/
+	if (!(verbose > 1 || debug))
+	{
+	    int want = (state == PS_TEXT ? '<' : '>');
+	    
+	    if (*cp != want)
+	    {
+		nl = 0;
+		
+		cp = (char *) scan_chr(cp, limit, want, &nl);
+		lastc = cp[-1];
+		line += nl;
+		if (cp >= limit)
+		{
+		    /* A newline right at the end is counted by the next chunk */
+		    line -= (lastc == '\n');
+		    break;
+		}
+	    }
+	}
+	    
+	switch (state)
+	{
+	  case PS_TEXT:
+	    if (*cp == '<')
+	    {
+		if (cp[1] == '<')
+		{
+		    ++cp;
+		    continue;
+		}
+		
+		if (cp[1] == '!' && cp[2] == '-' && cp[3] == '-')
+		{
+		    /* From the "--" of "<!--", so "<!-->" is a comment too */
+		    sp = cp;
+		    ++cp;
+		    state = PS_COMMENT;
+		    continue;
+		}
+
+		if (cp[1] == '!' && strncmp(cp, "<![CDATA[", 9) == 0)
+		{
+		    sp = cp;
+		    cp += 8;
+		    state = PS_CDATA;
+		    continue;
+		}
+		
+		sp = cp;
+		state = PS_TAG;
+	    }
+	    break;
+	    
+	  case PS_TAG:
+	    if (*cp == '>')
+	    {
+		if (cp[1] == '>') /* TODO: Remove this? */
+		{
+		    ++cp;
+		    continue;
+		}
+		
+		if (debug > 1)
+		    fprintf(stderr, "tag: %.*s\n", (int) (cp-sp+1), sp);
+		
+		if (!sp)
+		{
+		    state = 0;
+		    continue;
+		}
+		
+		tag = tag_class(sp);
+		pp->st.tags[tag]++;
+		if (!tp && tag != TAG_IMG && tag != TAG_TABLE &&
+		    tag != TAG_SCRIPT && tag != TAG_STYLE)
+		    tag = TAG_OTHER; /* Table structure tags outside tables */
+		
+		switch (tag)
+		{
+		  case TAG_SCRIPT:
+		  case TAG_STYLE:
+		    /* Raw text up to the end tag, skipped as a whole */
+		    state = (tag == TAG_SCRIPT ? PS_SCRIPT : PS_STYLE);
+		    continue;
+		    
+		  case TAG_IMG:
+		    if (tp && img_magic && strcmp(img_magic, "tidbokonline") == 0)
+		    {
+			/* Special magic for 'tidbokonline' */
+			
+			if (is_match(sp, cp-sp+1, "A.gif"))
+			{
+			    output(pp, tp, "Upptaget", 8, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, "D.gif"))
+			{
+			    output(pp, tp, "Abonnerad", 9, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, "E.gif"))
+			{
+			    output(pp, tp, "Boka", 4, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, "G.gif"))
+			{
+			    output(pp, tp, "St&auml;ngt", 11, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, "H.gif"))
+			{
+			    output(pp, tp, "Boka", 4, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, "L.gif") ||
+				 is_match(sp, cp-sp+1, "M.gif"))
+			{
+			    output(pp, tp, "Arrangemang", 11, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, "N.gif"))
+			{
+			    output(pp, tp, "Prolympia/JohnBauer", 19, rowspan, colspan);
+			    skip_cell = 1;
+			}
+			else if (is_match(sp, cp-sp+1, ".gif"))
+			{
+			    output(pp, tp, "???", 3, rowspan, colspan);
+			    skip_cell = 1;
+			}
+		    }
+		    else if (tp && table_hole(tp, sp, cp) < 0)
+		    {
+			fprintf(stderr, "%s: %s#%u: Out of memory\n", argv0, pp->path, line);
+			exit(1);
+		    }
+		    break;
+		
+		  case TAG_TABLE:
+		    if (tp)
+			tp->ta_s = sp;
+		    else
+		    {
+			/* Nothing carries over from a previous table */
+			rowspan = 1;
+			colspan = 1;
+			skip_cell = 0;
+		    }
+		    
+		    /* Resolve the selector first, so table_open() knows */
+		    hit = 1;
+		    if (match && sel->text)
+		    {
+			hit = is_match(sp, cp-sp+1, sel->text);
+			if (hit && (pp->tagged ? !pp->m_first : !m_no))
+			{
+			    if (pp->tagged)
+				pp->m_first = pp->tn+1;
+			    else
+				m_no = pp->tn+1;
+			}
+		    }
+		    else if (match)
+			hit = sel_table(sel, sp, cp);
+		    
+		    tp = table_open(pp, hit);
+		    if (!tp)
+		    {
+			fprintf(stderr, "%s: %s#%u: Error opening table (nesting too deep?)\n",
+				argv0, pp->path, line);
+			exit(1);
+		    }
+		    break;
+		
+		  case TAG_TABLE_END:
+		    if (tp->td_s)
+		    {
+			if (verbose || debug)
+			    fprintf(stderr, "%s#%u: Missing closing TD tag at /TABLE (auto-closed)\n",
+				    pp->path, line);
+			pp->st.td_closed++;
+			if (!skip_cell)
+			    output(pp, tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
+			skip_cell = 0;
+			tp->td_s = NULL;
+		    }
+
+		    if (tp->ro)
+		    {
+			if (verbose || debug)
+			    fprintf(stderr, "%s#%u: Missing closing TR tag at /TABLE (auto-closed)\n",
+				    pp->path, line);
+			pp->st.tr_closed++;
+			table_row_close(tp);
+		    }
+
+		    /* Never saw the caption or cell -M asked for */
+		    if (tp->pend)
+			table_reject(tp);
+		    
+		    if (table_is_last(pp, tp))
+			pp->done = 1;
+		    
+		    ntp = table_close(pp, tp);
+		    if (ntp)
+		    {
+			if (table_hole(ntp, ntp->ta_s, cp) < 0)
+			{
+			    fprintf(stderr, "%s: %s#%u: Out of memory\n", argv0, pp->path, line);
+			    exit(1);
+			}
+		    }
+		    else if (table_flush(pp) < 0)
+		    {
+			fprintf(stderr, "%s: %s: Error writing to output file: %s\n",
+				argv0, pp->outpath ? pp->outpath : "<stdout>", strerror(errno));
+			exit(1);
+		    }
+		    else
+			map_release(pp, sp);
+		    tp = ntp;
+		    break;
+		
+		  case TAG_TR:
+		    if (tp->td_s)
+		    {
+			pp->st.td_closed++;
+			if (!skip_cell)
+			{
+			    output(pp, tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
+			}
+			skip_cell = 0;
+			tp->td_s = NULL;
+		    }
+
+		    if (tp->ro)
+		    {
+			if (verbose || debug)
+			    fprintf(stderr, "%s#%u: Missing closing TR tag at new TR (auto-closed)\n",
+				    pp->path, line);
+			pp->st.tr_closed++;
+			table_row_close(tp);
+		    }
+
+		    table_row_open(tp);
+		    tp->td_s = NULL;
+		    
+		    /* Past the last row (-L) of the -M table */
+		    if (tp->rc > row_last && table_is_last(pp, tp))
+			pp->done = 1;
+		    break;
+		
+		  case TAG_TR_END:
+		    if (tp->td_s)
+		    {
+			if (verbose || debug)
+			    fprintf(stderr, "%s#%u: Missing closing TD tag at /TR (auto-closed)\n",
+				    pp->path, line);
+			pp->st.td_closed++;
+			if (!skip_cell)
+			    output(pp, tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
+			skip_cell = 0;
+			tp->td_s = NULL;
+		    }
+
+		    table_row_close(tp);
+		    tp->td_s = NULL;
+		    break;
+		
+		  case TAG_CAPTION:
+		    tp->td_s = cp+1;
+		    tp->hc = 0;
+		    break;
+		
+		  case TAG_CAPTION_END:
+		    if (tp->td_s)
+		    {
+			if (!skip_cell && !tp->skip)
+			{
+			    if (cell_text(pp, tp, tp->td_s, sp-tp->td_s, &tp->caption) < 0)
+				tp->caption.len = 0;
+			    else if (debug)
+				fprintf(stderr, "Got table id=%d caption: %.*s\n", tp->id,
+					(int) CELL_LEN(tp->caption), CELL_TEXT(tp, tp->caption));
+			    
+			    if (tp->pend & PEND_CAPTION)
+			    {
+				if ((tp->caption.len & CELL_SET) &&
+				    (!sel->cap || sel_text(sel->cap, CELL_TEXT(tp, tp->caption),
+							   CELL_LEN(tp->caption))))
+				    tp->pend &= ~PEND_CAPTION;
+				else
+				    table_reject(tp);
+			    }
+			}
+			skip_cell = 0;
+			tp->td_s = NULL;
+		    }
+		    break;
+		     
+		  case TAG_TD:
+		  case TAG_TH:
+		    if (!tp->ro)
+		    {
+			if (verbose || debug)
+			    fprintf(stderr, "%s#%u: Missing starting TR tag before TD or TH (auto-opened)\n",
+				    pp->path, line);
+			pp->st.tr_opened++;
+			
+			table_row_open(tp);
+		    }
+		    
+		    if (tp->td_s)
+		    {
+			if (verbose || debug)
+			    fprintf(stderr, "%s#%u: Missing closing TD or TH tag (auto-closed)\n",
+				    pp->path, line);
+			pp->st.td_closed++;
+			
+			if (!skip_cell)
+			    output(pp, tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
+			skip_cell = 0;
+			tp->td_s = NULL;
+		    }
+		    
+		    cell_spans(sp, cp, &rowspan, &colspan);
+		    tp->nc++;
+		    
+		    tp->td_s = cp+1;
+		    tp->hc = 0;
+		    break;
+		
+		  case TAG_TD_END:
+		  case TAG_TH_END:
+		    if (tp->td_s)
+		    {
+			if (!skip_cell)
+			    output(pp, tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
+			skip_cell = 0;
+			tp->td_s = NULL;
+		    }
+		    break;
+		
+		  default:
+		    if (tp && table_hole(tp, sp, cp) < 0)
+		    {
+			fprintf(stderr, "%s: %s#%u: Out of memory\n", argv0, pp->path, line);
+			exit(1);
+		    }
+		    break;
+		}
+		
+		state = PS_TEXT;
+	    }
+	    break;
+	    
+	  default:
+	    fprintf(stderr, "%s: Internal error: Invalid state: %d\n", argv0, state);
+	    exit(1);
+	}
+    }
+
+    pp->state = state;
+    pp->sp = sp;
+    pp->lastc = lastc;
+    pp->line = line;
+    pp->tp = tp;
+    pp->rowspan = rowspan;
+    pp->colspan = colspan;
+    pp->skip_cell = skip_cell;
+
+    pp->st.bytes += cp-start;
+    if (stats)
+	st_stop(&pp->st, &t, ST_PARSE);
+    
+    return cp;
+}
+
+
+/*
+** Lowest buffer position still referenced by the parser - everything
+** before it may be discarded.
+*/
+char *
+parser_keep(PARSER *pp,
+	    char *cp)
+{
+    int ti;
+    char *keep = cp;
+
+
+    if (pp->state != 0 && pp->sp && pp->sp < keep)
+	keep = pp->sp;
+    
+    for (ti = 0; ti < pp->tsc; ti++)
+	if (pp->tsv[ti]->td_s && pp->tsv[ti]->td_s < keep)
+	    keep = pp->tsv[ti]->td_s;
+
+    return keep;
+}
+
+
+/* Drop all parser references into an input buffer about to be released */
+void
+parser_release(PARSER *pp)
+{
+    int ti;
+
+
+    pp->sp = NULL;
+    
+    for (ti = 0; ti < pp->tsc; ti++)
+    {
+	pp->tsv[ti]->td_s = pp->tsv[ti]->ta_s = NULL;
+	pp->tsv[ti]->hc = 0;
+    }
+}
+
+
+char *
+rebase(char *p,
+       char *keep,
+       char *nbuf)
+{
+    if (!p || p < keep)
+	return NULL;
+    
+    return nbuf + (p-keep);
+}
+
+
+/*
+** Move all parser references from data starting at 'keep' to the same
+** data at 'nbuf'. References to discarded data are cleared.
+*/
+void
+parser_rebase(PARSER *pp,
+	      char *keep,
+	      char *nbuf)
+{
+    int ti;
+
+    
+    pp->sp = rebase(pp->sp, keep, nbuf);
+    
+    for (ti = 0; ti < pp->tsc; ti++)
+    {
+	pp->tsv[ti]->td_s = rebase(pp->tsv[ti]->td_s, keep, nbuf);
+	pp->tsv[ti]->ta_s = rebase(pp->tsv[ti]->ta_s, keep, nbuf);
+    }
+}
+
+
+/*
+** Set the input charset from the start of the document, unless
+** forced with -i.
+*/
+void
+parser_charset(PARSER *pp,
+	       const char *buf,
+	       size_t len)
+{
+    if (pp->charset < 0)
+	pp->charset = cs_sniff(buf, len);
+    if (pp->charset < 0)
+	pp->charset = CS_UTF8;
+
+    if (debug)
+	fprintf(stderr, "%s: input charset %s\n",
+		pp->path ? pp->path : "<stdin>", cs_name(pp->charset));
+}
+
+
+/*
+** Parse a stream (stdin, pipe or unmappable file) in chunks. Only the
+** data still referenced by the parser (a partial tag or comment start,
+** or the text of open cells) is kept between chunks, so memory use is
+** bounded by the largest cell rather than by the size of the input.
+*/
+int
+parse_stream(PARSER *pp,
+	     FILE *fp)
+{
+    char *buf, *nbuf, *cp, *keep;
+    size_t bufsize, buflen, bufpos, to_read, got, n;
+    int eof = 0;
+
+
+    bufsize = DEF_BUFSIZE;
+    buf = malloc(bufsize+1);
+    if (!buf)
+	return -1;
+
+    buflen = bufpos = 0;
+    while (!eof)
+    {
+	to_read = bufsize-buflen;
+	got = fread(buf+buflen, 1, to_read, fp);
+	if (debug > 1)
+	    fprintf(stderr, "parse_stream: fread(buflen=%lu, to_read=%lu) -> got=%lu\n",
+		    (unsigned long) buflen, (unsigned long) to_read, (unsigned long) got);
+	
+	if (got < to_read)
+	{
+	    if (ferror(fp))
+	    {
+		free(buf);
+		return -1;
+	    }
+	    eof = 1;
+	}
+	
+	buflen += got;
+	buf[buflen] = '\0';
+	
+	if (pp->charset < 0)
+	    parser_charset(pp, buf, buflen);
+	
+	cp = parse_buf(pp, buf+bufpos, buf+buflen, eof);
+	if (eof)
+	    break;
+
+	if (pp->done)
+	{
+	    /* Leave the rest unread, unless it should be drained (-a) */
+	    while (drain && fread(buf, 1, bufsize, fp) > 0)
+		;
+	    if (ferror(fp))
+	    {
+		free(buf);
+		return -1;
+	    }
+	    break;
+	}
+
+	/* Slide the still needed data down to the start of the buffer */
+	keep = parser_keep(pp, cp);
+	n = buf+buflen-keep;
+	
+	if (n > bufsize/2)
+	{
+	    /* Mostly full with data still in use - grow (double) it */
+	    if (debug > 1)
+		fprintf(stderr, "parse_stream: growing buffer to %lu bytes\n",
+			(unsigned long) bufsize*2);
+	    
+	    nbuf = malloc(bufsize*2+1);
+	    if (!nbuf)
+	    {
+		free(buf);
+		return -1;
+	    }
+	    
+	    memcpy(nbuf, keep, n);
+	    parser_rebase(pp, keep, nbuf);
+	    bufpos = cp-keep;
+	    free(buf);
+	    buf = nbuf;
+	    bufsize *= 2;
+	}
+	else
+	{
+	    memmove(buf, keep, n);
+	    parser_rebase(pp, keep, buf);
+	    bufpos = cp-keep;
+	}
+	buflen = n;
+    }
+    
+    parser_release(pp);
+    free(buf);
+    
+    return 0;
+}
+
+
+/*
+** Parse one input file. Regular files are memory mapped and parsed
+** in one go, everything else is parsed as a stream.
+*/
+int
+parse_file(PARSER *pp,
+	   const char *path)
+{
+    FILE *fp;
+    struct stat sb;
+    char *buf;
+    size_t buflen;
+    int ti, rc = 0;
+    ST_CLOCK t;
+    
+
+    /* All but the parsing (timed by parse_buf()) counts as loading */
+    if (stats)
+	st_start(&pp->st, &t, 1);
+    
+    pp->path = path;
+    pp->state = 0;
+    pp->sp = NULL;
+    pp->lastc = -1;
+    pp->line = 0;
+    pp->charset = in_charset;
+    
+    if (path && strcmp(path, "-") != 0)
+    {
+	fp = fopen(path, "r");
+	if (!fp)
+	{
+	    if (stats)
+		st_stop(&pp->st, &t, ST_LOAD);
+	    return -1;
+	}
+    }
+    else
+	fp = stdin;
+    
+    if (fstat(fileno(fp), &sb) == 0 && S_ISREG(sb.st_mode) && sb.st_size > 0)
+    {
+	buflen = sb.st_size;
+	buf = map_file(fileno(fp), buflen);
+	if (buf)
+	{
+	    pp->base = pp->kept = buf;
+	    pp->size = buflen;
+	    parser_charset(pp, buf, buflen);
+	    (void) parse_buf(pp, buf, buf+buflen, 1);
+	    
+	    parser_release(pp);
+	    pp->base = pp->kept = NULL;
+	    for (ti = 0; ti < pp->tc; ti++)
+		if (table_pin(pp->tv[ti]) < 0)
+		    rc = -1;
+	    
+	    munmap(buf, map_size(buflen));
+	    goto End;
+	}
+	
+	if (debug)
+	    fprintf(stderr, "parse_file: %s: mmap failed (%s), reading instead\n",
+		    path, strerror(errno));
+    }
+    
+    rc = parse_stream(pp, fp);
+
+  End:
+    if (fp != stdin)
+	fclose(fp);
+
+    if (stats)
+	st_stop(&pp->st, &t, ST_LOAD);
+    
+    return rc;
+}
+
+
+/*
+** Parallel parsing of multiple files (-j). Each worker parses a whole
+** file with its own parser context into a memory buffer, numbering
+** the tables from 1 and recording where each output line starts (see
+** print_id()). The main thread then puts the outputs together in
+** argument order, filling in the real table ids and doing the -M
+** selection, so the output is the same as when parsing serially.
+**
+** Large regular files are split into chunks at top-level tables (see
+** split_file()), which are parsed as separate jobs in the same way.
+**
+** Tables left open at the end of a file continue in the next one. In
+** that (rare) case the next file is parsed again by the main thread,
+** continuing the context of the previous one.
+*/
+typedef struct job {
+    const char *path;
+    char *map;       /* Mapping shared by the chunks of a split file */
+    size_t maplen;
+    size_t off;      /* Chunk of 'map' to parse */
+    size_t end;
+    int line;        /* Parser state at the start of the chunk */
+    int lastc;
+    int charset;
+    int part;        /* Chunk number in the file */
+    int last;        /* Last chunk (or the whole file) */
+    PARSER pb;
+    OUTBUF out;      /* Output of the worker */
+    int rc;          /* parse_file() result ... */
+    int err;         /* ... and errno */
+    int done;
+} JOB;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    JOB *jv;
+    int jn;
+    int js;
+    int next;        /* Next job to start */
+    int merged;      /* Jobs merged so far */
+    int window;      /* Max number of jobs ahead of the merge */
+} jq = { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, NULL, 0, 0, 0, 0, 0 };
+
+
+/* Release everything left in a parser context */
+void
+parser_free(PARSER *pp)
+{
+    int ti;
+
+
+    for (ti = 0; ti < pp->tc; ti++)
+	table_free(pp, pp->tv[ti]);
+    
+    free(pp->tv);
+    free(pp->lv);
+    free(pp->pv);
+    pp->tv = NULL;
+    pp->lv = NULL;
+    pp->pv = NULL;
+    pp->tc = pp->ts = pp->tsc = 0;
+    pp->lc = pp->ls = 0;
+    pp->pc = pp->ps = 0;
+}
+
+
+/*
+** A fresh context gives the same result as continuing 'pp' only if
+** no table is open (the cell state is reset at each top-level table).
+*/
+int
+parser_clean(PARSER *pp)
+{
+    return pp->tsc == 0;
+}
+
+
+/* Parse one chunk of a split file */
+int
+parse_chunk(PARSER *pp,
+	    JOB *jp)
+{
+    int ti, rc = 0;
+    ST_CLOCK t;
+
+
+    if (stats)
+	st_start(&pp->st, &t, 1);
+    
+    pp->path = jp->path;
+    pp->state = 0;
+    pp->sp = NULL;
+    pp->lastc = jp->lastc;
+    pp->line = jp->line;
+    pp->charset = jp->charset;
+    
+    pp->base = jp->map;
+    pp->size = jp->maplen;
+    (void) parse_buf(pp, jp->map+jp->off, jp->map+jp->end, 1);
+    
+    parser_release(pp);
+    pp->base = NULL;
+    for (ti = 0; ti < pp->tc; ti++)
+	if (table_pin(pp->tv[ti]) < 0)
+	    rc = -1;
+
+    if (stats)
+	st_stop(&pp->st, &t, ST_LOAD);
+    
+    return rc;
+}
+
+
+/* Append a (whole file) job to the queue */
+JOB *
+job_add(const char *path)
+{
+    JOB *jp;
+
+
+    if (jq.jn >= jq.js)
+    {
+	jq.js = jq.js ? jq.js*2 : 64;
+	jq.jv = realloc(jq.jv, jq.js*sizeof(JOB));
+	if (!jq.jv)
+	{
+	    fprintf(stderr, "%s: Out of memory\n", argv0);
+	    exit(1);
+	}
+    }
+
+    jp = &jq.jv[jq.jn++];
+    memset(jp, 0, sizeof(*jp));
+    jp->path = path;
+    jp->last = 1;
+    return jp;
+}
+
+
+/*
+** Split a large regular file into chunks at top-level <table> tags,
+** where the parser has no state but the line number. The boundaries
+** are found by running the tokenizer of parse_buf() over the mapped
+** file, only keeping track of the table nesting. Returns 1 if the
+** file was queued as chunks, 0 if it should be parsed as a whole.
+*/
+int
+split_file(const char *path)
+{
+    int fd, state, depth, nl, spnl, cs, tag;
+    struct stat sb;
+    size_t len, min;
+    char *buf, *cp, *end, *sp, *rp;
+    JOB *jp;
+
+
+    if (strcmp(path, "-") == 0)
+	return 0;
+    
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+	return 0;
+    
+    if (fstat(fd, &sb) < 0 || !S_ISREG(sb.st_mode) || (size_t) sb.st_size < 2*split_min)
+    {
+	close(fd);
+	return 0;
+    }
+
+    len = sb.st_size;
+    buf = map_file(fd, len);
+    close(fd);
+    if (!buf)
+	return 0;
+
+    cs = in_charset;
+    if (cs < 0)
+	cs = cs_sniff(buf, len);
+    if (cs < 0)
+	cs = CS_UTF8;
+
+    /* Aim for a few chunks per worker, but not too small ones */
+    min = len/(jobs*8);
+    if (min < split_min)
+	min = split_min;
+    
+    jp = job_add(path);
+    jp->map = buf;
+    jp->maplen = len;
+    jp->lastc = -1;
+    jp->charset = cs;
+    
+    state = depth = nl = spnl = 0;
+    sp = NULL;
+    end = buf+len;
+    for (cp = buf; (cp = (char *) scan_chr(cp, end, state == PS_TEXT ? '<' : '>', &nl)) < end; ++cp)
+    {
+	switch (state)
+	{
+	  case PS_TEXT:
+	    if (cp[1] == '<')
+	    {
+		++cp;
+		continue;
+	    }
+	    
+	    sp = cp;
+	    spnl = nl;
+	    if (cp[1] == '!' && cp[2] == '-' && cp[3] == '-')
+		state = PS_COMMENT;
+	    else if (cp[1] == '!' && strncmp(cp, "<![CDATA[", 9) == 0)
+		state = PS_CDATA;
+	    else
+	    {
+		state = PS_TAG;
+		break;
+	    }
+
+	    cp = raw_end(state, cp + (state == PS_COMMENT ? 2 : 9), end, 1, &rp, &nl);
+	    if (!cp)
+		cp = end-1;
+	    state = PS_TEXT;
+	    break;
+
+	  case PS_TAG:
+	    if (cp[1] == '>')
+	    {
+		++cp;
+		continue;
+	    }
+
+	    state = PS_TEXT;
+	    switch (tag = tag_class(sp))
+	    {
+	      case TAG_SCRIPT:
+	      case TAG_STYLE:
+		cp = raw_end(tag == TAG_SCRIPT ? PS_SCRIPT : PS_STYLE, cp+1, end, 1, &rp, &nl);
+		if (!cp)
+		    cp = end-1;
+		break;
+		
+	      case TAG_TABLE:
+		if (depth++ == 0 && (size_t) (sp-buf) >= jp->off+min)
+		{
+		    jp->end = sp-buf;
+		    jp->last = 0;
+		    
+		    jp = job_add(path);
+		    jp->map = buf;
+		    jp->maplen = len;
+		    jp->off = sp-buf;
+		    jp->lastc = sp[-1];
+		    jp->line = spnl+1 - (sp[-1] == '\n');
+		    jp->charset = cs;
+		    jp->part = jq.jv[jq.jn-2].part+1;
+		}
+		break;
+
+	      case TAG_TABLE_END:
+		if (depth > 0)
+		    --depth;
+		break;
+	    }
+	    break;
+	}
+    }
+    jp->end = len;
+
+    if (debug)
+	fprintf(stderr, "split_file: %s: %d chunk%s\n", path, jp->part+1, jp->part ? "s" : "");
+    
+    return 1;
+}
+
+
+void
+job_run(JOB *jp)
+{
+    PARSER *pp = &jp->pb;
+    
+    
+    memset(pp, 0, sizeof(*pp));
+    pp->rowspan = 1;
+    pp->colspan = 1;
+    pp->tagged = 1;
+    
+    if (ob_init(&jp->out, -1) < 0)
+    {
+	jp->rc = -1;
+	jp->err = errno;
+	return;
+    }
+    pp->out = &jp->out;
+    
+    if (jp->map)
+	jp->rc = parse_chunk(pp, jp);
+    else
+	jp->rc = parse_file(pp, jp->path);
+    jp->err = errno;
+    pp->out = NULL;
+}
+
+
+void *
+job_worker(void *arg)
+{
+    int k;
+
+
+    (void) arg;
+
+    pthread_mutex_lock(&jq.lock);
+    for (;;)
+    {
+	while (jq.next < jq.jn && jq.next >= jq.merged + jq.window)
+	    pthread_cond_wait(&jq.cond, &jq.lock);
+	
+	if (jq.next >= jq.jn)
+	    break;
+	
+	k = jq.next++;
+	pthread_mutex_unlock(&jq.lock);
+
+	if (debug)
+	    fprintf(stderr, "Parsing file: %s\n", jq.jv[k].path);
+	job_run(&jq.jv[k]);
+	
+	pthread_mutex_lock(&jq.lock);
+	jq.jv[k].done = 1;
+	pthread_cond_broadcast(&jq.cond);
+    }
+    pthread_mutex_unlock(&jq.lock);
+
+    return NULL;
+}
+
+
+/*
+** Append the output of a job to the output of 'pp', with the table ids
+** of the job offset by the number of tables seen before it.
+*/
+int
+job_merge(PARSER *pp,
+	  JOB *jp)
+{
+    PARSER *jpp = &jp->pb;
+    int li, id, ti, pi, i;
+    size_t pos, end;
+    char *cp;
+    
+
+    if (match && !m_no && jpp->m_first)
+	m_no = pp->tn + jpp->m_first;
+
+    /* Table ids in Arrow batches (little endian int32) */
+    for (pi = 0; pi < jpp->pc; pi++)
+	for (i = 0; i < jpp->pv[pi].n; i++)
+	{
+	    cp = jp->out.buf + jpp->pv[pi].pos + 4*i;
+	    id = pp->tn + ((unsigned char) cp[0] | (unsigned char) cp[1] << 8 |
+			   (unsigned char) cp[2] << 16 | (unsigned char) cp[3] << 24);
+	    cp[0] = id;
+	    cp[1] = id >> 8;
+	    cp[2] = id >> 16;
+	    cp[3] = id >> 24;
+	}
+    
+    for (li = 0; li < jpp->lc; li++)
+    {
+	pos = jpp->lv[li].pos;
+	end = (li+1 < jpp->lc ? (size_t) jpp->lv[li+1].pos : jp->out.len);
+	id = pp->tn + jpp->lv[li].id;
+	
+	if (m_no && id != m_no)
+	    continue;
+	
+	if (out_format != FMT_ARROW && put_lead(pp->out, id) < 0)
+	    return -1;
+
+	if (ob_write(pp->out, jp->out.buf+pos, end-pos) < 0)
+	    return -1;
+    }
+
+    pp->mem_used += jpp->mem_used;
+    pp->mem_size += jpp->mem_size;
+    pp->line = jpp->line;
+    
+    if (jpp->tc > 0)
+    {
+	/* Tables still open - continue with the context of the job */
+	for (ti = 0; ti < jpp->tc; ti++)
+	{
+	    jpp->tv[ti]->id += pp->tn;
+	    if (!jpp->tv[ti]->skip && !table_wanted(pp, jpp->tv[ti]->id, 1))
+		jpp->tv[ti]->skip = 1;
+	}
+	
+	free(pp->tv);
+	pp->tv = jpp->tv;
+	pp->tc = jpp->tc;
+	pp->ts = jpp->ts;
+	pp->tsc = jpp->tsc;
+	memcpy(pp->tsv, jpp->tsv, sizeof(pp->tsv[0])*jpp->tsc);
+	pp->tp = jpp->tp;
+	jpp->tv = NULL;
+	jpp->tc = jpp->ts = jpp->tsc = 0;
+    }
+    
+    pp->rowspan = jpp->rowspan;
+    pp->colspan = jpp->colspan;
+    pp->skip_cell = jpp->skip_cell;
+    pp->tn += jpp->tn;
+
+    /* Stop when the -M table is complete (also see table_is_last()) */
+    if (jpp->done)
+	pp->done = 1;
+    else if (match && m_id && m_no <= pp->tn)
+    {
+	pp->done = 1;
+	for (ti = 0; ti < pp->tsc; ti++)
+	    if (pp->tsv[ti]->id == m_no)
+		pp->done = 0;
+    }
+    
+    return 0;
+}
+
+
+/*
+** Parse 'nf' files with 'jobs' worker threads, continuing the parser
+** context 'pp'.
+*/
+void
+parse_files(PARSER *pp,
+	    char **files,
+	    int nf)
+{
+    int k, nt, jn, rc, reparse = 0;
+    pthread_t *thv;
+    JOB *jp;
+    ST_CLOCK t;
+
+
+    if (stats)
+	st_start(&pp->st, &t, 1);
+    
+    for (k = 0; k < nf; k++)
+	if (split_file(files[k]) == 0)
+	    (void) job_add(files[k]);
+    
+    if (stats)
+	st_stop(&pp->st, &t, ST_LOAD);
+    
+    thv = calloc(jobs, sizeof(pthread_t));
+    if (!thv)
+    {
+	fprintf(stderr, "%s: Out of memory\n", argv0);
+	exit(1);
+    }
+    
+    jq.window = jobs*2;
+    jn = jq.jn;
+    
+    for (nt = 0; nt < jobs && nt < jq.jn; nt++)
+	if (pthread_create(&thv[nt], NULL, job_worker, NULL) != 0)
+	{
+	    fprintf(stderr, "%s: Error starting thread: %s\n", argv0, strerror(errno));
+	    exit(1);
+	}
+
+    for (k = 0; k < jq.jn; k++)
+    {
+	jp = &jq.jv[k];
+	
+	pthread_mutex_lock(&jq.lock);
+	while (!jp->done)
+	    pthread_cond_wait(&jq.cond, &jq.lock);
+	pthread_mutex_unlock(&jq.lock);
+
+	if (jp->part == 0)
+	    reparse = !parser_clean(pp);
+	
+	if (pp->done)
+	    jp->rc = 0; /* Started before the -M table was complete */
+	else if (reparse)
+	{
+	    /* Continues tables from the previous file - parse it again */
+	    if (jp->part == 0)
+	    {
+		if (debug)
+		    fprintf(stderr, "Parsing file: %s (again, tables still open)\n", jp->path);
+		
+		jp->rc = parse_file(pp, jp->path);
+		jp->err = errno;
+	    }
+	    else
+		jp->rc = 0;
+	}
+	else if (jp->rc == 0)
+	{
+	    if (stats)
+		st_start(&pp->st, &t, 1);
+	    rc = job_merge(pp, jp);
+	    if (stats)
+		st_stop(&pp->st, &t, ST_EMIT);
+	    
+	    if (rc < 0)
+	    {
+		fprintf(stderr, "%s: %s: Error writing to output file: %s\n",
+			argv0, pp->outpath ? pp->outpath : "<stdout>", strerror(errno));
+		exit(1);
+	    }
+	}
+	
+	if (jp->rc < 0)
+	{
+	    fprintf(stderr, "%s: %s: Error reading file: %s\n", argv0, jp->path, strerror(jp->err));
+	    exit(1);
+	}
+
+	parser_free(&jp->pb);
+	st_add(&pp->st, &jp->pb.st);
+	ob_free(&jp->out);
+
+	pthread_mutex_lock(&jq.lock);
+	jq.merged = k+1;
+	if (pp->done && jq.next < jq.jn)
+	    jq.jn = jq.next; /* Nothing more to print - start no more jobs */
+	pthread_cond_broadcast(&jq.cond);
+	pthread_mutex_unlock(&jq.lock);
+	
+	if (jp->last)
+	{
+	    if (jp->map)
+		munmap(jp->map, map_size(jp->maplen));
+	    
+	    if (verbose)
+		fprintf(stderr, "%s: %d line%s parsed.\n", jp->path, pp->line, pp->line == 1 ? "" : "s");
+	}
+    }
+
+    for (k = 0; k < nt; k++)
+	pthread_join(thv[k], NULL);
+
+    /* Files of jobs never started (see pp->done) */
+    for (k = jq.jn; k < jn; k++)
+	if (jq.jv[k].last && jq.jv[k].map)
+	    munmap(jq.jv[k].map, map_size(jq.jv[k].maplen));
+
+    free(thv);
+    free(jq.jv);
+}
+
+
+/*
+** Parse a -j argument: the number of threads, optionally followed by
+** ",<size>", the smallest chunk (in bytes) a large file is split into.
+*/
+void
+set_jobs(const char *arg)
+{
+    const char *cp;
+    
+    
+    jobs = atoi(arg);
+    
+    cp = strchr(arg, ',');
+    if (cp)
+    {
+	split_min = strtoul(cp+1, NULL, 0);
+	if (split_min < 1)
+	    split_min = 1;
+    }
+}
+
+
+/*
+** Parse a -C column list, like "1,3,5-8" or "10-" (1-based), into
+** col_map, col_max and col_from. Returns -1 if it is not valid.
+*/
+int
+parse_cols(const char *str)
+{
+    const char *cp;
+    char *ep;
+    long a, b;
+    int pass;
+    
+
+    for (pass = 0; pass < 2; pass++)
+    {
+	if (pass == 1)
+	{
+	    col_map = calloc(col_max+2, 1);
+	    if (!col_map)
+		return -1;
+	}
+	
+	cp = str;
+	do
+	{
+	    if (*cp == ',')
+		++cp;
+	    
+	    a = 1;
+	    if (*cp != '-')
+	    {
+		a = strtol(cp, &ep, 10);
+		if (ep == cp || a < 1 || a > MAX_COLS)
+		    return -1;
+		cp = ep;
+	    }
+
+	    b = a;
+	    if (*cp == '-')
+	    {
+		++cp;
+		if (*cp && *cp != ',')
+		{
+		    b = strtol(cp, &ep, 10);
+		    if (ep == cp || b < a || b > MAX_COLS)
+			return -1;
+		    cp = ep;
+		}
+		else
+		    b = -1; /* To the last column */
+	    }
+
+	    if (pass == 0)
+	    {
+		if (b < 0 && a-1 < col_from)
+		    col_from = a-1;
+		else if (b-1 > col_max)
+		    col_max = b-1;
+	    }
+	    else
+		for (; a <= b; a++)
+		    col_map[a-1] = 1;
+	} while (*cp == ',');
+
+	if (*cp)
+	    return -1;
+    }
+
+    return 0;
+}
+
+
+/*
+** Parse a -L row range, "START:END" (1-based, either may be left out),
+** or just "N" for the first N rows.
+*/
+int
+parse_rows(const char *str)
+{
+    const char *cp = str;
+    char *ep;
+    long a = 1, b = INT_MAX;
+
+
+    if (*cp != ':')
+    {
+	a = strtol(cp, &ep, 10);
+	if (ep == cp || a < 1 || a > INT_MAX)
+	    return -1;
+	cp = ep;
+	
+	if (!*cp)
+	{
+	    /* Just a count */
+	    row_last = a-1;
+	    return 0;
+	}
+    }
+
+    if (*cp++ != ':')
+	return -1;
+    
+    if (*cp)
+    {
+	b = strtol(cp, &ep, 10);
+	if (ep == cp || *ep || b < a || b > INT_MAX)
+	    return -1;
+    }
+
+    row_first = a-1;
+    row_last = (b == INT_MAX ? INT_MAX : b-1);
+    return 0;
+}
+
+
+void
+print_version(FILE *fp)
+{
+    fprintf(fp, "[PHTX %s - Peter's HTML Table Extractor>]\n", version);
+}
+
+int
+main(int argc,
      char *argv[])
 {
-    char *buf;
-    size_t buflen;
-    int state = 0;
-    char *sp, *cp;
-    int nt, nc, nr, nf;
-    int ai, aj, ti;
-    TABLE *tp = NULL;
-    int rowspan = 1;
-    int colspan = 1;
-    int skip_cell = 0;
-    int lastc = -1;
-    int line;
+    int nf;
+    int ai, aj;
+    PARSER pb;
     char *outpath = NULL;
+    char *in_cs = NULL;
+    char *out_cs = NULL;
+    char *out_fmt = NULL;
+    char *cols = NULL;
+    char *rows = NULL;
+    int d_set = 0;
     FILE *outfp = NULL;
+    OUTBUF out;
+    const char *errp;
+    double t0;
     
 
-    for (ai = 1; ai < argc && argv[ai][0] == '-'; ai++)
+    for (ai = 1; ai < argc && argv[ai][0] == '-' && argv[ai][1]; ai++)
     {
 	for (aj = 1; argv[ai][aj]; aj++)
 	{
@@ -732,14 +3928,23 @@ main(int argc,
 		puts("   -c           Output table caption (if defined)");
 		puts("   -f           Fill-out tables to equal length rows");
 		puts("   -R           Row/Col-Span repeat mode");
+		puts("   -b           One blank per tag, comment or nested table in a cell");
 		puts("   -v           Increase verbosity level");
 		puts("   -s           Increase whitespace strip level");
 		puts("   -d           Increase debug level");
+		puts("   -T           Print statistics to stderr (-TT as JSON)");
 		puts("   -I <mode>    IMG special magic mode");
 		puts("   -E <string>  String to print instead of empty cells");
 		puts("   -D <delim>   CSV field separator (default ';')");
-		puts("   -M <match>   Table selector");
+		puts("   -M <sel>     Table selector (like table.data or 3, see the manual)");
+		puts("   -a           Read all input, also after the selected table");
+		puts("   -C <columns> Columns to output (like 1,3,5-8)");
+		puts("   -L <rows>    Rows to output (START:END, or N for the first N)");
 		puts("   -O <path>    Output file");
+		puts("   -F <format>  Output format (csv, csv-rfc4180, tsv, jsonl or arrow)");
+		puts("   -j <jobs>    Number of parallel parser threads (<jobs>,<size>: min split size)");
+		puts("   -i <charset> Input charset (default: from BOM or <meta>, else utf-8)");
+		puts("   -e <charset> Output charset (default utf-8)");
 		exit(0);
 
 	      case '-':
@@ -761,6 +3966,10 @@ main(int argc,
 		++p_caption;
 		break;
 		
+	      case 'a':
+		++drain;
+		break;
+		
 	      case 'r':
 		++p_rowno;
 		break;
@@ -769,6 +3978,10 @@ main(int argc,
 		++fill_out;
 		break;
 		
+	      case 'b':
+		++p_squeeze;
+		break;
+		
 	      case 'R':
 		++span_repeat;
 		break;
@@ -784,97 +3997,210 @@ main(int argc,
 	      case 'v':
 		++verbose;
 		break;
-		
-	      case 'I':
+		
+	      case 'T':
+		++stats;
+		break;
+		
+	      case 'I':
+		if (argv[ai][aj+1])
+		{
+		    img_magic = strdup(argv[ai]+aj+1);
+		    goto NextArg;
+		}
+		else if (argv[ai+1])
+		{
+		    img_magic = strdup(argv[++ai]);
+		    goto NextArg;
+		}
+		else
+		{
+		    fprintf(stderr, "%s: Missing required argument for -I\n", argv[0]);
+		    exit(1);
+		}
+		break;
+
+	      case 'E':
+		if (argv[ai][aj+1])
+		{
+		    empty = strdup(argv[ai]+aj+1);
+		    goto NextArg;
+		}
+		else if (argv[ai+1])
+		{
+		    empty = strdup(argv[++ai]);
+		    goto NextArg;
+		}
+		else
+		{
+		    fprintf(stderr, "%s: Missing required argument for -E\n", argv[0]);
+		    exit(1);
+		}
+		break;
+
+	      case 'D':
+		++d_set;
+		if (argv[ai][aj+1])
+		{
+		    delim = strdup(argv[ai]+aj+1);
+		    goto NextArg;
+		}
+		else if (argv[ai+1])
+		{
+		    delim = strdup(argv[++ai]);
+		    goto NextArg;
+		}
+		else
+		{
+		    fprintf(stderr, "%s: Missing required argument for -D\n", argv[0]);
+		    exit(1);
+		}
+		break;
+
+	      case 'O':
+		if (argv[ai][aj+1])
+		{
+		    outpath = strdup(argv[ai]+aj+1);
+		    goto NextArg;
+		}
+		else if (argv[ai+1])
+		{
+		    outpath = strdup(argv[++ai]);
+		    goto NextArg;
+		}
+		else
+		{
+		    fprintf(stderr, "%s: Missing required argument for -O\n", argv[0]);
+		    exit(1);
+		}
+		break;
+
+	      case 'F':
+		if (argv[ai][aj+1])
+		{
+		    out_fmt = strdup(argv[ai]+aj+1);
+		    goto NextArg;
+		}
+		else if (argv[ai+1])
+		{
+		    out_fmt = strdup(argv[++ai]);
+		    goto NextArg;
+		}
+		else
+		{
+		    fprintf(stderr, "%s: Missing required argument for -F\n", argv[0]);
+		    exit(1);
+		}
+		break;
+
+	      case 'j':
 		if (argv[ai][aj+1])
 		{
-		    img_magic = strdup(argv[ai]+aj+1);
+		    set_jobs(argv[ai]+aj+1);
 		    goto NextArg;
 		}
 		else if (argv[ai+1])
 		{
-		    img_magic = strdup(argv[++ai]);
+		    set_jobs(argv[++ai]);
 		    goto NextArg;
 		}
 		else
 		{
-		    fprintf(stderr, "%s: Missing required argument for -I\n", argv[0]);
+		    fprintf(stderr, "%s: Missing required argument for -j\n", argv[0]);
 		    exit(1);
 		}
 		break;
 
-	      case 'E':
+	      case 'M':
 		if (argv[ai][aj+1])
 		{
-		    empty = strdup(argv[ai]+aj+1);
+		    match = strdup(argv[ai]+aj+1);
 		    goto NextArg;
 		}
 		else if (argv[ai+1])
 		{
-		    empty = strdup(argv[++ai]);
+		    match = strdup(argv[++ai]);
 		    goto NextArg;
 		}
 		else
 		{
-		    fprintf(stderr, "%s: Missing required argument for -E\n", argv[0]);
+		    fprintf(stderr, "%s: Missing required argument for -M\n", argv[0]);
 		    exit(1);
 		}
 		break;
-
-	      case 'D':
+		
+	      case 'C':
 		if (argv[ai][aj+1])
 		{
-		    delim = strdup(argv[ai]+aj+1);
+		    cols = strdup(argv[ai]+aj+1);
 		    goto NextArg;
 		}
 		else if (argv[ai+1])
 		{
-		    delim = strdup(argv[++ai]);
+		    cols = strdup(argv[++ai]);
 		    goto NextArg;
 		}
 		else
 		{
-		    fprintf(stderr, "%s: Missing required argument for -D\n", argv[0]);
+		    fprintf(stderr, "%s: Missing required argument for -C\n", argv[0]);
 		    exit(1);
 		}
 		break;
-
-	      case 'O':
+		
+	      case 'L':
 		if (argv[ai][aj+1])
 		{
-		    outpath = strdup(argv[ai]+aj+1);
+		    rows = strdup(argv[ai]+aj+1);
 		    goto NextArg;
 		}
 		else if (argv[ai+1])
 		{
-		    outpath = strdup(argv[++ai]);
+		    rows = strdup(argv[++ai]);
 		    goto NextArg;
 		}
 		else
 		{
-		    fprintf(stderr, "%s: Missing required argument for -O\n", argv[0]);
+		    fprintf(stderr, "%s: Missing required argument for -L\n", argv[0]);
+		    exit(1);
+		}
+		break;
+		
+	      case 'i':
+		if (argv[ai][aj+1])
+		{
+		    in_cs = strdup(argv[ai]+aj+1);
+		    goto NextArg;
+		}
+		else if (argv[ai+1])
+		{
+		    in_cs = strdup(argv[++ai]);
+		    goto NextArg;
+		}
+		else
+		{
+		    fprintf(stderr, "%s: Missing required argument for -i\n", argv[0]);
 		    exit(1);
 		}
 		break;
 
-	      case 'M':
+	      case 'e':
 		if (argv[ai][aj+1])
 		{
-		    match = strdup(argv[ai]+aj+1);
+		    out_cs = strdup(argv[ai]+aj+1);
 		    goto NextArg;
 		}
 		else if (argv[ai+1])
 		{
-		    match = strdup(argv[++ai]);
+		    out_cs = strdup(argv[++ai]);
 		    goto NextArg;
 		}
 		else
 		{
-		    fprintf(stderr, "%s: Missing required argument for -M\n", argv[0]);
+		    fprintf(stderr, "%s: Missing required argument for -e\n", argv[0]);
 		    exit(1);
 		}
 		break;
-		
+
 	      default:
 		fprintf(stderr, "%s: -%c: Invalid switch\n", argv[0], argv[ai][aj]);
 		exit(1);
@@ -884,337 +4210,90 @@ main(int argc,
     }
 
   EndArg:
+    argv0 = argv[0];
+    t0 = st_wall();
+    
+    /* Before any -j threads are started, so they are counted too */
+    if (stats)
+	st_hw_start();
+    
+    if (debug)
+	fprintf(stderr, "Using %s scanner\n", scan_init());
+    else
+	(void) scan_init();
+    
     if (verbose)
 	print_version(stderr);
     
     if (match)
-	sscanf(match, "%u", &m_no);
-    
-    nf = 0;
-    for (; ai < argc; ai++)
     {
-	if (debug)
-	    fprintf(stderr, "Parsing file: %s\n", argv[ai]);
-
-	buf = load_file(argv[ai], &buflen);
-	if (!buf)
+	sel = sel_compile(match, &errp);
+	if (!sel)
 	{
-	    fprintf(stderr, "%s: %s: Error loading file: %s\n", argv[0], argv[ai], strerror(errno));
+	    if (errno == ENOMEM)
+		fprintf(stderr, "%s: Out of memory\n", argv[0]);
+	    else
+		fprintf(stderr, "%s: %s: Invalid selector at: %s\n", argv[0], match,
+			*errp ? errp : "<end>");
 	    exit(1);
 	}
-
-	++nf;
-	line = 0;
-	state = 0;
-	cp = buf;
-	sp = NULL;
-	nt = nc = nr = 0;
-
-	lastc = -1;
-	for (cp = buf; *cp; lastc = *cp, ++cp)
+	
+	m_no = sel->nth;
+	m_id = (m_no > 0);
+	m_one = (m_id || sel->text);
+    }
+    
+    if (cols && parse_cols(cols) < 0)
+    {
+	fprintf(stderr, "%s: %s: Invalid column list\n", argv[0], cols);
+	exit(1);
+    }
+    
+    if (rows && parse_rows(rows) < 0)
+    {
+	fprintf(stderr, "%s: %s: Invalid row range\n", argv[0], rows);
+	exit(1);
+    }
+    
+    projecting = (cols || rows);
+    
+    if (in_cs && (in_charset = cs_lookup(in_cs, -1)) < 0)
+    {
+	fprintf(stderr, "%s: %s: Unknown charset\n", argv[0], in_cs);
+	exit(1);
+    }
+    
+    if (out_cs && (out_charset = cs_lookup(out_cs, -1)) < 0)
+    {
+	fprintf(stderr, "%s: %s: Unknown charset\n", argv[0], out_cs);
+	exit(1);
+    }
+    
+    if (out_fmt)
+    {
+	if (strcmp(out_fmt, "arrow") == 0)
+	    out_format = FMT_ARROW;
+	else if (strcmp(out_fmt, "csv-rfc4180") == 0)
 	{
-	    if (lastc == -1 || lastc == '\n')
-	    {
-		++line;
-		if (verbose > 1 || debug)
-		{
-		    fprintf(stderr, "%s#%u: >> ", argv[ai], line);
-		    print_line(cp, stderr);
-		}
-	    }
-		
-	    switch (state)
-	    {
-	      case 0:
-		if (*cp == '<')
-		{
-		    if (cp[1] == '<')
-		    {
-			++cp;
-			continue;
-		    }
-		    
-		    if (cp[1] == '!' && cp[2] == '-' && cp[3] == '-')
-		    {
-			sp = cp;
-			cp = cp+4;
-			while (!(cp[-2] == '-' && cp[-1] == '-' && cp[0] == '>'))
-			{
-			    if (*cp == '\n' && 0)
-				++line;
-			    ++cp;
-			}
-			if (*cp)
-			    ++cp;
-			if (debug > 1)
-			    fprintf(stderr, "comment: %.*s\n", (int) (cp-sp+1), sp);
-			memset(sp, ' ', cp-sp);
-			continue;
-		    }
-		    
-		    sp = cp;
-		    state = 1;
-		}
-		break;
-		
-	      case 1:
-		if (*cp == '>')
-		{
-		    if (cp[1] == '>') /* TODO: Remove this? */
-		    {
-			++cp;
-			continue;
-		    }
-		    
-		    if (debug > 1)
-			fprintf(stderr, "tag: %.*s\n", (int) (cp-sp+1), sp);
-		    
-		    if (!sp)
-		    {
-			state = 0;
-			continue;
-		    }
-		    
-		    if (is_tag(sp, "IMG"))
-		    {
-			if (img_magic && strcmp(img_magic, "tidbokonline") == 0)
-			{
-			    /* Special magic for 'tidbokonline' */
-			    
-			    if (is_match(sp, cp-sp+1, "A.gif"))
-			    {
-				output(tp, "Upptaget", 9, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, "D.gif"))
-			    {
-				output(tp, "Abonnerad", 10, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, "E.gif"))
-			    {
-				output(tp, "Boka", 5, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, "G.gif"))
-			    {
-				output(tp, "Stngt", 6, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, "H.gif"))
-			    {
-				output(tp, "Boka", 5, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, "L.gif") ||
-				     is_match(sp, cp-sp+1, "M.gif"))
-			    {
-				output(tp, "Arrangemang", 12, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, "N.gif"))
-			    {
-				output(tp, "Prolympia/JohnBauer", 21, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			    else if (is_match(sp, cp-sp+1, ".gif"))
-			    {
-				output(tp, "???", 21, rowspan, colspan);
-				skip_cell = 1;
-			    }
-			}
-			else
-			    memset(sp, ' ', cp-sp+1);
-		    }
-		    
-		    else if (is_tag(sp, "TABLE"))
-		    {
-			if (tp)
-			    tp->ta_s = sp;
-			
-			tp = table_open();
-			
-			if (!m_no && match && is_match(sp, cp-sp+1, match))
-			    m_no = tp->id;
-		    }
-		    
-		    else if (is_tag(sp, "/TABLE"))
-		    {
-			TABLE *ntp;
-			
-			if (tp->td_s)
-			{
-			    if (verbose || debug)
-				fprintf(stderr, "%s#%u: Missing closing TD tag at /TABLE (auto-closed)\n",
-					argv[ai], line);
-			    if (!skip_cell)
-				output(tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
-			    skip_cell = 0;
-			    tp->td_s = NULL;
-			}
-
-			if (tp->rp)
-			{
-			    if (verbose || debug)
-				fprintf(stderr, "%s#%u: Missing closing TR tag at /TABLE (auto-closed)\n",
-					argv[ai], line);
-			    table_row_close(tp);
-			}
-			
-			ntp = table_close(tp);
-			if (ntp)
-			{
-			    if (ntp->ta_s)
-				memset(ntp->ta_s, ' ', cp - ntp->ta_s+1);
-			    tp = ntp;
-			}
-		    }
-		    
-		    else if (tp && is_tag(sp, "TR"))
-		    {
-			if (tp->td_s)
-			{
-			    if (!skip_cell)
-			    {
-				output(tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
-			    }
-			    skip_cell = 0;
-			    tp->td_s = NULL;
-			}
-
-			if (tp->rp != NULL)
-			{
-			    if (verbose || debug)
-				fprintf(stderr, "%s#%u: Missing closing TR tag at new TR (auto-closed)\n",
-					argv[ai], line);
-			    table_row_close(tp);
-			}
-
-			table_row_open(tp);
-			tp->td_s = NULL;
-		    }
-		    
-		    else if (tp && is_tag(sp, "/TR"))
-		    {
-			if (tp->td_s)
-			{
-			    if (verbose || debug)
-				fprintf(stderr, "%s#%u: Missing closing TD tag at /TR (auto-closed)\n",
-					argv[ai], line);
-			    if (!skip_cell)
-				output(tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
-			    skip_cell = 0;
-			    tp->td_s = NULL;
-			}
-
-			table_row_close(tp);
-			tp->td_s = NULL;
-		    }
-		    
-		    else if (tp && is_tag(sp, "CAPTION"))
-		    {
-			tp->td_s = cp+1;
-		    }
-		    
-		    else if (tp && is_tag(sp, "/CAPTION"))
-		    {
-			if (tp->td_s)
-			{
-			    if (!skip_cell)
-			    {
-				tp->caption = ent_decode(tp->td_s, sp-tp->td_s);
-				if (debug)
-				    fprintf(stderr, "Got table id=%d caption: %s\n", tp->id, tp->caption);
-			    }
-			    skip_cell = 0;
-			    tp->td_s = NULL;
-			}
-		    }
-			 
-		    else if (tp && (is_tag(sp, "TD") || is_tag(sp, "TH")))
-		    {
-			char *xp, tc;
-			
-
-			if (tp->rp == NULL)
-			{
-			    if (verbose || debug)
-				fprintf(stderr, "%s#%u: Missing starting TR tag before TD or TH (auto-opened)\n",
-				        argv[ai], line);
-			    
-			    table_row_open(tp);
-			}
-			
-			if (tp->td_s)
-			{
-			    if (verbose || debug)
-				fprintf(stderr, "%s#%u: Missing closing TD or TH tag (auto-closed)\n",
-					argv[ai], line);
-			    
-			    if (!skip_cell)
-				output(tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
-			    skip_cell = 0;
-			    tp->td_s = NULL;
-			}
-			
-			rowspan = 1;
-			tc = *cp;
-			*cp = '\0';
-			xp = strstr(sp, "rowspan");
-			*cp = tc;
-			if (xp)
-			{
-			    if (sscanf(xp,"rowspan=%d", &rowspan) != 1)
-				(void) sscanf(xp,"rowspan=\"%d\"", &rowspan);
-			}
-			
-			colspan = 1;
-			tc = *cp;
-			*cp = '\0';
-			xp = strstr(sp, "colspan");
-			*cp = tc;
-			if (xp)
-			{
-			    if (sscanf(xp,"colspan=%d", &colspan) != 1)
-				(void) sscanf(xp,"colspan=\"%d\"", &colspan);
-			}
-			
-			tp->td_s = cp+1;
-		    }
-		    
-		    else if (tp && (is_tag(sp, "/TD") || is_tag(sp, "/TH")))
-		    {
-			if (tp->td_s)
-			{
-			    if (!skip_cell)
-				output(tp, tp->td_s, sp-tp->td_s, rowspan, colspan);
-			    skip_cell = 0;
-			    tp->td_s = NULL;
-			}
-		    }
-		    
-		    else
-		    {
-			memset(sp, ' ', cp-sp+1);
-		    }
-		    
-		    state = 0;
-		}
-		break;
-		
-	      default:
-		fprintf(stderr, "%s: Internal error: Invalid state: %d\n", argv[0], state);
-		exit(1);
-	    }
+	    out_format = FMT_RFC4180;
+	    eol = "\r\n";
+	    if (!d_set)
+		delim = ",";
+	}
+	else if (strcmp(out_fmt, "tsv") == 0)
+	{
+	    out_format = FMT_TSV;
+	    delim = "\t";
+	}
+	else if (strcmp(out_fmt, "jsonl") == 0)
+	    out_format = FMT_JSONL;
+	else if (strcmp(out_fmt, "csv") != 0)
+	{
+	    fprintf(stderr, "%s: %s: Unknown output format\n", argv[0], out_fmt);
+	    exit(1);
 	}
-
-	if (verbose)
-	    fprintf(stderr, "%s: %d line%s parsed.\n", argv[ai], line, line == 1 ? "" : "s");
     }
     
-    if (verbose)
-	fprintf(stderr, "Total: %d file%s parsed, %d table%s found.\n", nf, nf == 1 ? "" : "s", tc, tc == 1 ? "" : "s");
-
     if (outpath)
     {
 	outfp = fopen(outpath, "w");
@@ -1227,16 +4306,57 @@ main(int argc,
     }
     else
 	outfp = stdout;
+
+    /* All output goes through 'out', never through stdio */
+    if (ob_init(&out, fileno(outfp)) < 0)
+    {
+	fprintf(stderr, "%s: Out of memory\n", argv[0]);
+	exit(1);
+    }
+    
+    memset(&pb, 0, sizeof(pb));
+    pb.out = &out;
+    pb.outpath = outpath;
+    pb.rowspan = 1;
+    pb.colspan = 1;
+    
+    nf = 0;
+    if (jobs > 1 && argc-ai > 0)
+    {
+	parse_files(&pb, argv+ai, argc-ai);
+	nf = argc-ai;
+	ai = argc;
+    }
     
-    for (ti = 0; ti < tc; ti++)
+    for (; ai < argc && !pb.done; ai++)
     {
-	if (!m_no || tv[ti]->id == m_no)
-	    if (table_print_csv(tv[ti], outfp) < 0)
-	    {
-		fprintf(stderr, "%s: %s: Error writing to output file: %s\n",
-			argv[0], outpath, strerror(errno));
-		exit(1);
-	    }
+	if (debug)
+	    fprintf(stderr, "Parsing file: %s\n", argv[ai]);
+
+	if (parse_file(&pb, argv[ai]) < 0)
+	{
+	    fprintf(stderr, "%s: %s: Error reading file: %s\n", argv[0], argv[ai], strerror(errno));
+	    exit(1);
+	}
+
+	++nf;
+	if (verbose)
+	    fprintf(stderr, "%s: %d line%s parsed.\n", argv[ai], pb.line, pb.line == 1 ? "" : "s");
+    }
+    
+    /* Print tables left open at end of input */
+    if (table_flush(&pb) < 0)
+    {
+	fprintf(stderr, "%s: %s: Error writing to output file: %s\n",
+		argv[0], outpath ? outpath : "<stdout>", strerror(errno));
+	exit(1);
+    }
+
+    if (verbose)
+    {
+	fprintf(stderr, "Total: %d file%s parsed, %d table%s found.\n", nf, nf == 1 ? "" : "s", pb.tn, pb.tn == 1 ? "" : "s");
+	fprintf(stderr, "Table memory: %lu bytes used, %lu allocated.\n",
+		(unsigned long) pb.mem_used, (unsigned long) pb.mem_size);
     }
 
     if (outfp != stdout)
@@ -1246,6 +4366,9 @@ main(int argc,
 		    argv[0], outpath, strerror(errno));
 	    exit(1);
 	}
+
+    if (stats)
+	st_print(stderr, &pb.st, tag_names, st_wall()-t0, stats > 1);
     
     return 0;
 }
@@ -0,0 +1,453 @@
+/*
+** scan.c - Fast delimiter scanning
+**
+** Used by the parser to skip over runs of text between the characters
+** it actually cares about and over comments and scripts (scan_pair()
+** finds the start of their terminator), by the charset code to find the end of
+** runs of plain ASCII and by the output code to find characters that
+** need escaping. SSE2 and AVX2 versions are selected at runtime (x86
+** with GCC/Clang only), with a portable fallback.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "scan.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+
+static const char *
+scan_chr_scalar(const char *p,
+		const char *end,
+		int c,
+		int *nlp)
+{
+    int nl = 0;
+
+
+    for (; p < end && *p != c; ++p)
+	if (*p == '\n')
+	    ++nl;
+
+    *nlp += nl;
+    return p;
+}
+
+
+static const char *
+scan_pair_scalar(const char *p,
+		 const char *end,
+		 int c0,
+		 int c1,
+		 int *nlp)
+{
+    int nl = 0;
+
+
+    for (; end-p >= 2; ++p)
+    {
+	if (*p == c0 && p[1] == c1)
+	{
+	    *nlp += nl;
+	    return p;
+	}
+	if (*p == '\n')
+	    ++nl;
+    }
+
+    /* The last byte can not start a pair */
+    if (p < end && *p == '\n')
+	++nl;
+    
+    *nlp += nl;
+    return end;
+}
+
+
+static const char *
+scan_high_scalar(const char *p,
+		 const char *end)
+{
+    while (p < end && !(*p & 0x80))
+	++p;
+
+    return p;
+}
+
+
+static const char *
+scan_esc_scalar(const char *p,
+		const char *end,
+		const char *set,
+		int flags)
+{
+    unsigned char c;
+
+
+    for (; p < end; ++p)
+    {
+	c = *p;
+	if (((flags & SCAN_CTL) && c < 0x20) ||
+	    ((flags & SCAN_HIGH) && c >= 0x80) ||
+	    (c && strchr(set, c)))
+	    return p;
+    }
+
+    return p;
+}
+
+
+#ifdef HAVE_X86_SIMD
+
+/* Up to four set characters, repeating the first for unused slots */
+static void
+esc_set(const char *set,
+	char *sv)
+{
+    int i, n = strlen(set);
+
+
+    for (i = 0; i < 4; i++)
+	sv[i] = set[i < n ? i : 0];
+}
+
+
+__attribute__((target("sse2")))
+static const char *
+scan_esc_sse2(const char *p,
+	      const char *end,
+	      const char *set,
+	      int flags)
+{
+    char sv[4];
+    __m128i v0, v1, v2, v3, vc, v, m;
+    unsigned int bits;
+
+
+    if (strlen(set) > 4)
+	return scan_esc_scalar(p, end, set, flags);
+    
+    esc_set(set, sv);
+    v0 = _mm_set1_epi8(sv[0]);
+    v1 = _mm_set1_epi8(sv[1]);
+    v2 = _mm_set1_epi8(sv[2]);
+    v3 = _mm_set1_epi8(sv[3]);
+    vc = _mm_set1_epi8(0x1F);
+    
+    for (; end-p >= 16; p += 16)
+    {
+	v = _mm_loadu_si128((const __m128i *) p);
+	m = _mm_setzero_si128();
+	if (set[0])
+	    m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, v0), _mm_cmpeq_epi8(v, v1)),
+			     _mm_or_si128(_mm_cmpeq_epi8(v, v2), _mm_cmpeq_epi8(v, v3)));
+	if (flags & SCAN_CTL)
+	    m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(v, vc), v));
+	if (flags & SCAN_HIGH)
+	    m = _mm_or_si128(m, v);
+	
+	bits = (unsigned int) _mm_movemask_epi8(m);
+	if (bits)
+	    return p+__builtin_ctz(bits);
+    }
+
+    return scan_esc_scalar(p, end, set, flags);
+}
+
+
+__attribute__((target("avx2")))
+static const char *
+scan_esc_avx2(const char *p,
+	      const char *end,
+	      const char *set,
+	      int flags)
+{
+    char sv[4];
+    __m256i v0, v1, v2, v3, vc, v, m;
+    unsigned int bits;
+
+
+    if (strlen(set) > 4)
+	return scan_esc_scalar(p, end, set, flags);
+    
+    esc_set(set, sv);
+    v0 = _mm256_set1_epi8(sv[0]);
+    v1 = _mm256_set1_epi8(sv[1]);
+    v2 = _mm256_set1_epi8(sv[2]);
+    v3 = _mm256_set1_epi8(sv[3]);
+    vc = _mm256_set1_epi8(0x1F);
+    
+    for (; end-p >= 32; p += 32)
+    {
+	v = _mm256_loadu_si256((const __m256i *) p);
+	m = _mm256_setzero_si256();
+	if (set[0])
+	    m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, v0), _mm256_cmpeq_epi8(v, v1)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(v, v2), _mm256_cmpeq_epi8(v, v3)));
+	if (flags & SCAN_CTL)
+	    m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(v, vc), v));
+	if (flags & SCAN_HIGH)
+	    m = _mm256_or_si256(m, v);
+	
+	bits = (unsigned int) _mm256_movemask_epi8(m);
+	if (bits)
+	    return p+__builtin_ctz(bits);
+    }
+
+    return scan_esc_sse2(p, end, set, flags);
+}
+
+
+__attribute__((target("sse2")))
+static const char *
+scan_high_sse2(const char *p,
+	       const char *end)
+{
+    unsigned int m;
+
+
+    for (; end-p >= 16; p += 16)
+    {
+	m = (unsigned int) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) p));
+	if (m)
+	    return p+__builtin_ctz(m);
+    }
+
+    return scan_high_scalar(p, end);
+}
+
+
+__attribute__((target("avx2")))
+static const char *
+scan_high_avx2(const char *p,
+	       const char *end)
+{
+    unsigned int m;
+
+
+    for (; end-p >= 32; p += 32)
+    {
+	m = (unsigned int) _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *) p));
+	if (m)
+	    return p+__builtin_ctz(m);
+    }
+
+    return scan_high_sse2(p, end);
+}
+
+
+__attribute__((target("sse2")))
+static const char *
+scan_chr_sse2(const char *p,
+	      const char *end,
+	      int c,
+	      int *nlp)
+{
+    __m128i vc = _mm_set1_epi8((char) c);
+    __m128i vn = _mm_set1_epi8('\n');
+    unsigned int m, n;
+    int nl = 0;
+
+
+    for (; end-p >= 16; p += 16)
+    {
+	__m128i v = _mm_loadu_si128((const __m128i *) p);
+
+	m = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(v, vc));
+	n = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(v, vn));
+	if (m)
+	{
+	    int i = __builtin_ctz(m);
+
+	    *nlp += nl + __builtin_popcount(n & ((1U << i)-1));
+	    return p+i;
+	}
+	nl += __builtin_popcount(n);
+    }
+
+    *nlp += nl;
+    return scan_chr_scalar(p, end, c, nlp);
+}
+
+
+__attribute__((target("avx2")))
+static const char *
+scan_chr_avx2(const char *p,
+	      const char *end,
+	      int c,
+	      int *nlp)
+{
+    __m256i vc = _mm256_set1_epi8((char) c);
+    __m256i vn = _mm256_set1_epi8('\n');
+    unsigned int m, n;
+    int nl = 0;
+
+
+    for (; end-p >= 32; p += 32)
+    {
+	__m256i v = _mm256_loadu_si256((const __m256i *) p);
+
+	m = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vc));
+	n = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vn));
+	if (m)
+	{
+	    int i = __builtin_ctz(m);
+
+	    *nlp += nl + __builtin_popcount(n & ((1U << i)-1));
+	    return p+i;
+	}
+	nl += __builtin_popcount(n);
+    }
+
+    *nlp += nl;
+    return scan_chr_sse2(p, end, c, nlp);
+}
+
+
+
+/*
+** Compare each 16 (32) byte block and the same block shifted by one
+** with the two characters, so a pair is found wherever it is.
+*/
+__attribute__((target("sse2")))
+static const char *
+scan_pair_sse2(const char *p,
+	       const char *end,
+	       int c0,
+	       int c1,
+	       int *nlp)
+{
+    __m128i v0 = _mm_set1_epi8((char) c0);
+    __m128i v1 = _mm_set1_epi8((char) c1);
+    __m128i vn = _mm_set1_epi8('\n');
+    unsigned int m, n;
+    int nl = 0;
+
+
+    for (; end-p > 16; p += 16)
+    {
+	__m128i a = _mm_loadu_si128((const __m128i *) p);
+	__m128i b = _mm_loadu_si128((const __m128i *) (p+1));
+
+	m = (unsigned int) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, v0),
+							  _mm_cmpeq_epi8(b, v1)));
+	n = (unsigned int) _mm_movemask_epi8(_mm_cmpeq_epi8(a, vn));
+	if (m)
+	{
+	    int i = __builtin_ctz(m);
+
+	    *nlp += nl + __builtin_popcount(n & ((1U << i)-1));
+	    return p+i;
+	}
+	nl += __builtin_popcount(n);
+    }
+
+    *nlp += nl;
+    return scan_pair_scalar(p, end, c0, c1, nlp);
+}
+
+
+__attribute__((target("avx2")))
+static const char *
+scan_pair_avx2(const char *p,
+	       const char *end,
+	       int c0,
+	       int c1,
+	       int *nlp)
+{
+    __m256i v0 = _mm256_set1_epi8((char) c0);
+    __m256i v1 = _mm256_set1_epi8((char) c1);
+    __m256i vn = _mm256_set1_epi8('\n');
+    unsigned int m, n;
+    int nl = 0;
+
+
+    for (; end-p > 32; p += 32)
+    {
+	__m256i a = _mm256_loadu_si256((const __m256i *) p);
+	__m256i b = _mm256_loadu_si256((const __m256i *) (p+1));
+
+	m = (unsigned int) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, v0),
+								 _mm256_cmpeq_epi8(b, v1)));
+	n = (unsigned int) _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, vn));
+	if (m)
+	{
+	    int i = __builtin_ctz(m);
+
+	    *nlp += nl + __builtin_popcount(n & ((1U << i)-1));
+	    return p+i;
+	}
+	nl += __builtin_popcount(n);
+    }
+
+    *nlp += nl;
+    return scan_pair_sse2(p, end, c0, c1, nlp);
+}
+
+#endif
+
+
+const char *
+(*scan_chr)(const char *p,
+	    const char *end,
+	    int c,
+	    int *nlp) = scan_chr_scalar;
+
+const char *
+(*scan_pair)(const char *p,
+	     const char *end,
+	     int c0,
+	     int c1,
+	     int *nlp) = scan_pair_scalar;
+
+const char *
+(*scan_high)(const char *p,
+	     const char *end) = scan_high_scalar;
+
+const char *
+(*scan_esc)(const char *p,
+	    const char *end,
+	    const char *set,
+	    int flags) = scan_esc_scalar;
+
+
+/*
+** Select the best implementation for this CPU. Returns the name of the
+** selected implementation.
+*/
+const char *
+scan_init(void)
+{
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+	scan_chr = scan_chr_avx2;
+	scan_pair = scan_pair_avx2;
+	scan_high = scan_high_avx2;
+	scan_esc = scan_esc_avx2;
+	return "avx2";
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+	scan_chr = scan_chr_sse2;
+	scan_pair = scan_pair_sse2;
+	scan_high = scan_high_sse2;
+	scan_esc = scan_esc_sse2;
+	return "sse2";
+    }
+#endif
+
+    scan_chr = scan_chr_scalar;
+    scan_pair = scan_pair_scalar;
+    scan_high = scan_high_scalar;
+    scan_esc = scan_esc_scalar;
+    return "scalar";
+}
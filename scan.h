@@ -0,0 +1,53 @@
+/* scan.h */
+
+#ifndef PHTX_SCAN_H
+#define PHTX_SCAN_H
+
+/*
+** Find the first occurrence of 'c' in [p, end) and add the number of
+** newlines before it to *nlp. Returns 'end' if 'c' was not found.
+*/
+extern const char *
+(*scan_chr)(const char *p,
+	    const char *end,
+	    int c,
+	    int *nlp);
+
+/*
+** Find the first position in [p, end) where 'c0' is followed by 'c1'
+** and add the number of newlines before it to *nlp. Returns 'end' if
+** there is none.
+*/
+extern const char *
+(*scan_pair)(const char *p,
+	     const char *end,
+	     int c0,
+	     int c1,
+	     int *nlp);
+
+/*
+** Find the first byte with the high bit set (non-ASCII) in [p, end).
+** Returns 'end' if there is none.
+*/
+extern const char *
+(*scan_high)(const char *p,
+	     const char *end);
+
+/*
+** Find the first byte in [p, end) that is one of the (up to 4) bytes
+** in 'set', or a control character (SCAN_CTL) or non-ASCII (SCAN_HIGH).
+** Returns 'end' if there is none.
+*/
+#define SCAN_CTL  1 /* < 0x20 */
+#define SCAN_HIGH 2 /* >= 0x80 */
+
+extern const char *
+(*scan_esc)(const char *p,
+	    const char *end,
+	    const char *set,
+	    int flags);
+
+extern const char *
+scan_init(void);
+
+#endif
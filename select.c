@@ -0,0 +1,700 @@
+/*
+** select.c - Table selectors (-M)
+**
+** A selector is compiled once into a SELECTOR, that the parser checks
+** as the tags arrive. The syntax is a small subset of CSS:
+**
+**   table#id table.class table[attr] table[attr=value] table[attr*=value]
+**   table:nth(N) table:has-caption table:has-caption(pattern)
+**   table > tr:nth(N) td:nth(N):contains(pattern)
+**
+** where a pattern is a "string" (or 'string') to look for, or a /regex/
+** (POSIX extended, /regex/i to ignore case). The row and cell parts are
+** optional, white space and '>' between the parts mean the same, and
+** 'th' is the same as 'td'. For compatibility a plain number selects a
+** table by id, and any other text that isn't a selector is looked for
+** in the TABLE tag.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <errno.h>
+#include <limits.h>
+#include <regex.h>
+
+#include "select.h"
+#include "attr.h"
+
+
+/* Is 'str' found in the 'len' bytes at 'buf'? */
+static int
+find_str(const char *buf,
+	 size_t len,
+	 const char *str)
+{
+    const char *cp, *end = buf+len;
+    size_t slen = strlen(str);
+
+
+    if (slen == 0)
+	return 1;
+
+    for (cp = buf; (size_t) (end-cp) >= slen; cp++)
+    {
+	cp = memchr(cp, str[0], end-cp-slen+1);
+	if (!cp)
+	    return 0;
+	if (memcmp(cp, str, slen) == 0)
+	    return 1;
+    }
+
+    return 0;
+}
+
+
+static void
+skip_ws(const char **cpp)
+{
+    while (isspace((unsigned char) **cpp))
+	++*cpp;
+}
+
+
+static int
+is_ident(int c)
+{
+    return isalnum(c) || c == '-' || c == '_' || c >= 0x80;
+}
+
+
+/* Skip the keyword 'w' (any case) if it is next */
+static int
+get_word(const char **cpp,
+	 const char *w)
+{
+    size_t len = strlen(w);
+
+
+    if (strncasecmp(*cpp, w, len) != 0 || is_ident((unsigned char) (*cpp)[len]))
+	return 0;
+
+    *cpp += len;
+    return 1;
+}
+
+
+static char *
+get_ident(const char **cpp,
+	  int lower)
+{
+    const char *cp = *cpp;
+    char *buf;
+    size_t i, len;
+
+
+    while (is_ident((unsigned char) *cp))
+	++cp;
+
+    len = cp-*cpp;
+    if (len == 0)
+    {
+	errno = EINVAL;
+	return NULL;
+    }
+
+    buf = malloc(len+1);
+    if (!buf)
+	return NULL;
+
+    for (i = 0; i < len; i++)
+	buf[i] = lower ? tolower((unsigned char) (*cpp)[i]) : (*cpp)[i];
+    buf[len] = '\0';
+
+    *cpp = cp;
+    return buf;
+}
+
+
+/* A string quoted with 'q' (at *cpp), '\' escapes the next character */
+static char *
+get_quoted(const char **cpp,
+	   int q)
+{
+    const char *cp = *cpp+1;
+    char *buf;
+    size_t len = 0;
+
+
+    buf = malloc(strlen(cp)+1);
+    if (!buf)
+	return NULL;
+
+    for (; *cp && *cp != q; cp++)
+    {
+	if (*cp == '\\' && cp[1])
+	{
+	    /* Regular expressions keep their escapes, but for "\/" */
+	    if (q == '/' && cp[1] != '/')
+		buf[len++] = *cp;
+	    ++cp;
+	}
+	buf[len++] = *cp;
+    }
+
+    if (*cp != q)
+    {
+	free(buf);
+	errno = EINVAL;
+	return NULL;
+    }
+
+    buf[len] = '\0';
+    *cpp = cp+1;
+    return buf;
+}
+
+
+static int
+get_num(const char **cpp)
+{
+    const char *cp = *cpp;
+    int n = 0;
+
+
+    if (!isdigit((unsigned char) *cp))
+	return -1;
+
+    for (; isdigit((unsigned char) *cp); cp++)
+	n = (n > (INT_MAX-9)/10 ? INT_MAX : n*10 + (*cp-'0'));
+
+    if (n == 0)
+	return -1;
+
+    *cpp = cp;
+    return n;
+}
+
+
+static SEL_PAT *
+get_pat(const char **cpp)
+{
+    const char *cp = *cpp;
+    SEL_PAT *pp;
+    char *str;
+    int flags = REG_EXTENDED|REG_NOSUB;
+
+
+    if (*cp != '"' && *cp != '\'' && *cp != '/')
+    {
+	errno = EINVAL;
+	return NULL;
+    }
+
+    str = get_quoted(&cp, *cp);
+    if (!str)
+	return NULL;
+
+    pp = malloc(sizeof(*pp));
+    if (!pp)
+    {
+	free(str);
+	return NULL;
+    }
+
+    if (**cpp != '/')
+    {
+	pp->str = str;
+	*cpp = cp;
+	return pp;
+    }
+
+    if (*cp == 'i')
+    {
+	flags |= REG_ICASE;
+	++cp;
+    }
+
+    pp->str = NULL;
+    if (regcomp(&pp->re, str, flags) != 0)
+    {
+	free(str);
+	free(pp);
+	errno = EINVAL;
+	return NULL;
+    }
+
+    free(str);
+    *cpp = cp;
+    return pp;
+}
+
+
+static void
+free_pat(SEL_PAT *pp)
+{
+    if (!pp)
+	return;
+
+    if (pp->str)
+	free(pp->str);
+    else
+	regfree(&pp->re);
+    free(pp);
+}
+
+
+/* Skip '(' and the white space after it, or ')' and that before it */
+static int
+paren(const char **cpp,
+      int c)
+{
+    if (c == ')')
+	skip_ws(cpp);
+    if (**cpp != c)
+    {
+	errno = EINVAL;
+	return -1;
+    }
+
+    ++*cpp;
+    if (c == '(')
+	skip_ws(cpp);
+    return 0;
+}
+
+
+/* (N) */
+static int
+get_nth(const char **cpp)
+{
+    int n;
+
+
+    if (paren(cpp, '(') < 0)
+	return -1;
+
+    if ((n = get_num(cpp)) < 0)
+    {
+	errno = EINVAL;
+	return -1;
+    }
+
+    return paren(cpp, ')') < 0 ? -1 : n;
+}
+
+
+/* (pattern) */
+static SEL_PAT *
+get_pat_arg(const char **cpp)
+{
+    SEL_PAT *pp;
+
+
+    if (paren(cpp, '(') < 0 || (pp = get_pat(cpp)) == NULL)
+	return NULL;
+
+    if (paren(cpp, ')') < 0)
+    {
+	free_pat(pp);
+	return NULL;
+    }
+
+    return pp;
+}
+
+
+static int
+add_attr(SELECTOR *sp,
+	 int op,
+	 char *name,
+	 char *value)
+{
+    if (!name || (op != SA_HAS && !value) || sp->na >= SEL_MAXATTRS)
+    {
+	if (sp->na >= SEL_MAXATTRS)
+	    errno = EINVAL;
+	free(name);
+	free(value);
+	return -1;
+    }
+
+    sp->av[sp->na].op = op;
+    sp->av[sp->na].name = name;
+    sp->av[sp->na].value = value;
+    sp->na++;
+    return 0;
+}
+
+
+/* [name], [name=value] or [name*=value] at *cpp */
+static int
+get_attr(SELECTOR *sp,
+	 const char **cpp)
+{
+    const char *cp = *cpp+1;
+    char *name, *value;
+    int op;
+
+
+    skip_ws(&cp);
+    *cpp = cp;
+    name = get_ident(cpp, 1);
+    if (!name)
+	return -1;
+
+    skip_ws(cpp);
+    op = SA_HAS;
+    value = NULL;
+    if (**cpp == '=' || ((*cpp)[0] == '*' && (*cpp)[1] == '='))
+    {
+	op = (**cpp == '=' ? SA_EQ : SA_SUB);
+	*cpp += (op == SA_EQ ? 1 : 2);
+	skip_ws(cpp);
+	value = (**cpp == '"' || **cpp == '\'') ? get_quoted(cpp, **cpp) : get_ident(cpp, 0);
+	if (!value)
+	{
+	    free(name);
+	    return -1;
+	}
+	skip_ws(cpp);
+    }
+
+    if (**cpp != ']')
+    {
+	free(name);
+	free(value);
+	errno = EINVAL;
+	return -1;
+    }
+
+    ++*cpp;
+    return add_attr(sp, op, name, value);
+}
+
+
+/* The conditions after 'table' */
+static int
+get_table(SELECTOR *sp,
+	  const char **cpp)
+{
+    for (;;)
+	switch (**cpp)
+	{
+	  case '#':
+	    ++*cpp;
+	    if (add_attr(sp, SA_EQ, strdup("id"), get_ident(cpp, 0)) < 0)
+		return -1;
+	    break;
+
+	  case '.':
+	    ++*cpp;
+	    if (add_attr(sp, SA_WORD, strdup("class"), get_ident(cpp, 0)) < 0)
+		return -1;
+	    break;
+
+	  case '[':
+	    if (get_attr(sp, cpp) < 0)
+		return -1;
+	    break;
+
+	  case ':':
+	    ++*cpp;
+	    if (get_word(cpp, "nth"))
+	    {
+		if (sp->nth)
+		    goto Invalid;
+		if ((sp->nth = get_nth(cpp)) < 0)
+		    return -1;
+	    }
+	    else if (get_word(cpp, "has-caption"))
+	    {
+		if (sp->caption)
+		    goto Invalid;
+		sp->caption = 1;
+		if (**cpp == '(' && !(sp->cap = get_pat_arg(cpp)))
+		    return -1;
+	    }
+	    else
+		goto Invalid;
+	    break;
+
+	  default:
+	    return 0;
+	}
+
+  Invalid:
+    errno = EINVAL;
+    return -1;
+}
+
+
+/* The conditions after 'td' */
+static int
+get_cell(SELECTOR *sp,
+	 const char **cpp)
+{
+    while (**cpp == ':')
+    {
+	++*cpp;
+	if (get_word(cpp, "nth"))
+	{
+	    if (sp->col)
+		goto Invalid;
+	    if ((sp->col = get_nth(cpp)) < 0)
+		return -1;
+	}
+	else if (get_word(cpp, "contains"))
+	{
+	    if (sp->cell)
+		goto Invalid;
+	    if (!(sp->cell = get_pat_arg(cpp)))
+		return -1;
+	}
+	else
+	    goto Invalid;
+    }
+
+    return 0;
+
+  Invalid:
+    errno = EINVAL;
+    return -1;
+}
+
+
+/* The row and cell parts, ' ' or '>' before each */
+static int
+get_parts(SELECTOR *sp,
+	  const char **cpp)
+{
+    const char *cp;
+    int part = 0;
+
+
+    for (;;)
+    {
+	cp = *cpp;
+	skip_ws(cpp);
+	if (**cpp == '>')
+	{
+	    ++*cpp;
+	    skip_ws(cpp);
+	}
+	else if (!**cpp)
+	    return 0;
+	else if (*cpp == cp)
+	    goto Invalid;
+
+	if (part == 0 && get_word(cpp, "tr"))
+	{
+	    part = 1;
+	    if (**cpp == ':')
+	    {
+		++*cpp;
+		if (!get_word(cpp, "nth"))
+		    goto Invalid;
+		if ((sp->row = get_nth(cpp)) < 0)
+		    return -1;
+	    }
+	}
+	else if (part < 2 && (get_word(cpp, "td") || get_word(cpp, "th")))
+	{
+	    part = 2;
+	    if (get_cell(sp, cpp) < 0)
+		return -1;
+	}
+	else
+	    goto Invalid;
+
+	sp->cells = 1;
+    }
+
+  Invalid:
+    errno = EINVAL;
+    return -1;
+}
+
+
+static void
+sel_clear(SELECTOR *sp)
+{
+    int i;
+
+
+    for (i = 0; i < sp->na; i++)
+    {
+	free(sp->av[i].name);
+	free(sp->av[i].value);
+    }
+    free_pat(sp->cap);
+    free_pat(sp->cell);
+    free(sp->text);
+    memset(sp, 0, sizeof(*sp));
+}
+
+
+SELECTOR *
+sel_compile(const char *str,
+	    const char **errp)
+{
+    SELECTOR *sp;
+    const char *cp = str;
+    int n;
+
+
+    *errp = str;
+    sp = calloc(1, sizeof(*sp));
+    if (!sp)
+	return NULL;
+
+    skip_ws(&cp);
+    if ((n = get_num(&cp)) > 0)
+    {
+	skip_ws(&cp);
+	if (!*cp)
+	{
+	    sp->nth = n;
+	    return sp;
+	}
+    }
+
+    cp = str;
+    skip_ws(&cp);
+    if (get_word(&cp, "table"))
+    {
+	*errp = cp;
+	if (get_table(sp, errp) == 0 && get_parts(sp, errp) == 0)
+	    return sp;
+
+	/* Like "table border=1", but not a broken row or cell part */
+	if (errno != ENOMEM && isspace((unsigned char) *cp))
+	{
+	    skip_ws(&cp);
+	    if (*cp != '>' && !get_word(&cp, "tr") && !get_word(&cp, "td") &&
+		!get_word(&cp, "th"))
+		cp = NULL;
+	}
+
+	if (cp)
+	{
+	    sel_free(sp);
+	    return NULL;
+	}
+	sel_clear(sp);
+    }
+
+    sp->text = strdup(str);
+    if (!sp->text)
+    {
+	free(sp);
+	return NULL;
+    }
+    return sp;
+}
+
+
+int
+sel_table(const SELECTOR *sp,
+	  const char *buf,
+	  const char *end)
+{
+    const SEL_ATTR *sa;
+    const char *cp, *ep;
+    size_t len;
+    ATTR ab;
+    int i;
+
+
+    for (i = 0; i < sp->na; i++)
+    {
+	sa = &sp->av[i];
+	if (!attr_find(buf, end, sa->name, &ab))
+	    return 0;
+	if (sa->op == SA_HAS)
+	    continue;
+
+	if (!ab.val)
+	    return 0;
+	len = strlen(sa->value);
+
+	switch (sa->op)
+	{
+	  case SA_EQ:
+	    if (ab.vlen != len || memcmp(ab.val, sa->value, len) != 0)
+		return 0;
+	    break;
+
+	  case SA_SUB:
+	    if (!find_str(ab.val, ab.vlen, sa->value))
+		return 0;
+	    break;
+
+	  case SA_WORD:
+	    /* One of the white space separated words */
+	    cp = ab.val;
+	    ep = ab.val+ab.vlen;
+	    for (;;)
+	    {
+		while (cp < ep && isspace((unsigned char) *cp))
+		    ++cp;
+		if (cp >= ep)
+		    return 0;
+		if ((size_t) (ep-cp) >= len && memcmp(cp, sa->value, len) == 0 &&
+		    (cp+len == ep || isspace((unsigned char) cp[len])))
+		    break;
+		while (cp < ep && !isspace((unsigned char) *cp))
+		    ++cp;
+	    }
+	    break;
+	}
+    }
+
+    return 1;
+}
+
+
+int
+sel_text(const SEL_PAT *pp,
+	 const char *buf,
+	 size_t len)
+{
+#ifdef REG_STARTEND
+    regmatch_t rm;
+#else
+    char *tmp;
+    int rc;
+#endif
+
+
+    if (pp->str)
+	return find_str(buf, len, pp->str);
+
+#ifdef REG_STARTEND
+    rm.rm_so = 0;
+    rm.rm_eo = len;
+    return regexec(&pp->re, buf, 1, &rm, REG_STARTEND) == 0;
+#else
+    tmp = malloc(len+1);
+    if (!tmp)
+	return 0;
+    memcpy(tmp, buf, len);
+    tmp[len] = '\0';
+    rc = (regexec(&pp->re, tmp, 0, NULL, 0) == 0);
+    free(tmp);
+    return rc;
+#endif
+}
+
+
+void
+sel_free(SELECTOR *sp)
+{
+    if (!sp)
+	return;
+
+    sel_clear(sp);
+    free(sp);
+}
@@ -0,0 +1,75 @@
+/* select.h */
+
+#ifndef PHTX_SELECT_H
+#define PHTX_SELECT_H
+
+#include <regex.h>
+
+/* A "string" (substring) or /regex/ (POSIX extended) to look for */
+typedef struct sel_pat {
+    char *str;       /* The substring, or NULL for 're' */
+    regex_t re;
+} SEL_PAT;
+
+/* Conditions on the attributes of the TABLE tag */
+#define SA_HAS   0   /* [name] */
+#define SA_EQ    1   /* [name=value], #id */
+#define SA_SUB   2   /* [name*=value] */
+#define SA_WORD  3   /* .class, 'value' is one of the words */
+
+typedef struct sel_attr {
+    int op;
+    char *name;      /* Lower case */
+    char *value;
+} SEL_ATTR;
+
+#define SEL_MAXATTRS 16
+
+/*
+** A compiled -M selector. The TABLE tag conditions are checked when
+** the table is opened, the caption and cell conditions when those have
+** been parsed (the table is kept until then).
+*/
+typedef struct selector {
+    char *text;      /* Plain text -M: a substring of the TABLE tag */
+    int nth;         /* :nth(N), the table id, or 0 */
+    int na;
+    SEL_ATTR av[SEL_MAXATTRS];
+
+    int caption;     /* :has-caption */
+    SEL_PAT *cap;    /* ... with a pattern */
+
+    int cells;       /* Has a row (tr) or cell (td) part */
+    int row;         /* tr:nth(N), or 0 for any row */
+    int col;         /* td:nth(N), or 0 for any cell in the row */
+    SEL_PAT *cell;   /* td:contains() */
+} SELECTOR;
+
+
+/*
+** Compile the selector 'str'. Returns NULL on error, with *errp set to
+** where in 'str' the error is (and errno to ENOMEM if out of memory).
+*/
+extern SELECTOR *
+sel_compile(const char *str,
+	    const char **errp);
+
+/*
+** Does the TABLE tag at 'buf' ('end' at the '>') satisfy the attribute
+** conditions of the selector?
+*/
+extern int
+sel_table(const SELECTOR *sp,
+	  const char *buf,
+	  const char *end);
+
+/* Is the pattern found in the 'len' bytes of text at 'buf'? */
+extern int
+sel_text(const SEL_PAT *pp,
+	 const char *buf,
+	 size_t len);
+
+extern void
+sel_free(SELECTOR *sp);
+
+#endif
@@ -0,0 +1,285 @@
+/*
+** stats.c - Run time statistics (-T)
+**
+** Each parser context keeps its own counters and phase times, which
+** are added up when the -j workers are merged. Time spent in a phase
+** nested inside another one (emit and decode happen in the middle of
+** parsing) is only counted for the inner phase. The thread CPU clock
+** is a system call, so very short sections (the decoding of a single
+** cell) are timed with the wall clock only. They get the share of the
+** CPU time of the section around them that their wall time is of it.
+**
+** Hardware counters are read with perf_event_open() when the kernel
+** allows it (see /proc/sys/kernel/perf_event_paranoid), else they are
+** silently left out.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "stats.h"
+
+static const char *phase_names[ST_PHASES] = {
+    "load", "parse", "decode", "emit"
+};
+
+#ifdef __NR_perf_event_open
+static struct {
+    const char *name;
+    unsigned long long config;
+    int fd;
+} hw[] = {
+    { "cycles",        PERF_COUNT_HW_CPU_CYCLES,       -1 },
+    { "instructions",  PERF_COUNT_HW_INSTRUCTIONS,     -1 },
+    { "cache_misses",  PERF_COUNT_HW_CACHE_MISSES,     -1 },
+    { "branch_misses", PERF_COUNT_HW_BRANCH_MISSES,    -1 },
+    { NULL,            0,                              -1 }
+};
+#endif
+
+
+double
+st_wall(void)
+{
+    struct timespec ts;
+
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+
+static double
+st_cpu(void)
+{
+    struct timespec ts;
+
+
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) < 0)
+	return 0;
+
+    return ts.tv_sec + ts.tv_nsec/1e9;
+}
+
+
+/*
+** Start timing a section, with (cpu != 0) or without the thread CPU
+** clock. The phase it counts towards is given to st_stop().
+*/
+void
+st_start(STATS *sp,
+	 ST_CLOCK *cp,
+	 int cpu)
+{
+    int i;
+
+
+    cp->in_wall = cp->in_cpu = 0;
+    for (i = 0; i < ST_PHASES; i++)
+    {
+	cp->in_wall += sp->wall[i];
+	cp->in_cpu += sp->cpu[i];
+    }
+
+    cp->cpu = cpu ? st_cpu() : -1;
+    cp->wall = st_wall();
+}
+
+
+/* Add the time since st_start() (less nested sections) to 'phase' */
+void
+st_stop(STATS *sp,
+	ST_CLOCK *cp,
+	int phase)
+{
+    double w, c, r, in_wall = 0, in_cpu = 0;
+    int i;
+
+
+    w = st_wall() - cp->wall;
+    c = (cp->cpu < 0 ? -1 : st_cpu() - cp->cpu);
+
+    if (c >= 0)
+    {
+	/* CPU time of the sections timed by the wall clock only */
+	r = (w > 0 && c < w ? c/w : 1);
+	for (i = 0; i < ST_PHASES; i++)
+	{
+	    sp->cpu[i] += sp->est[i]*r;
+	    sp->est[i] = 0;
+	}
+    }
+    
+    for (i = 0; i < ST_PHASES; i++)
+    {
+	in_wall += sp->wall[i];
+	in_cpu += sp->cpu[i];
+    }
+    w -= in_wall - cp->in_wall;
+    if (w < 0)
+	w = 0;
+    
+    sp->wall[phase] += w;
+    if (c < 0)
+	sp->est[phase] += w;
+    else
+    {
+	c -= in_cpu - cp->in_cpu;
+	sp->cpu[phase] += (c > 0 ? c : 0);
+    }
+}
+
+
+void
+st_add(STATS *dst,
+       const STATS *src)
+{
+    int i;
+
+
+    for (i = 0; i < ST_PHASES; i++)
+    {
+	dst->wall[i] += src->wall[i];
+	dst->cpu[i] += src->cpu[i];
+	dst->est[i] += src->est[i];
+    }
+
+    dst->bytes += src->bytes;
+    for (i = 0; i < ST_MAXTAGS; i++)
+	dst->tags[i] += src->tags[i];
+
+    dst->cells += src->cells;
+    dst->span_cells += src->span_cells;
+    dst->entities += src->entities;
+    dst->td_closed += src->td_closed;
+    dst->tr_closed += src->tr_closed;
+    dst->tr_opened += src->tr_opened;
+    dst->allocs += src->allocs;
+    dst->alloc_bytes += src->alloc_bytes;
+}
+
+
+/*
+** Start the hardware counters for the whole process. Must be called
+** before any threads are started (they inherit the counters).
+*/
+void
+st_hw_start(void)
+{
+#ifdef __NR_perf_event_open
+    struct perf_event_attr pa;
+    int i;
+
+
+    for (i = 0; hw[i].name; i++)
+    {
+	memset(&pa, 0, sizeof(pa));
+	pa.size = sizeof(pa);
+	pa.type = PERF_TYPE_HARDWARE;
+	pa.config = hw[i].config;
+	pa.inherit = 1;
+	pa.exclude_kernel = 1;
+	pa.exclude_hv = 1;
+
+	hw[i].fd = syscall(__NR_perf_event_open, &pa, 0, -1, -1, 0);
+    }
+#endif
+}
+
+
+/*
+** Print the statistics 'sp' of a run that took 'wall' seconds, as text
+** or as a single line JSON object. 'tag_names' holds the names of the
+** counted tag classes, NULL terminated.
+*/
+void
+st_print(FILE *fp,
+	 const STATS *sp,
+	 const char **tag_names,
+	 double wall,
+	 int json)
+{
+    struct rusage ru;
+    double cpu = 0;
+    unsigned long long v;
+    long rss = 0;
+    int i;
+
+
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+    {
+	cpu = ru.ru_utime.tv_sec + ru.ru_utime.tv_usec/1e6 +
+	    ru.ru_stime.tv_sec + ru.ru_stime.tv_usec/1e6;
+	rss = ru.ru_maxrss; /* KB on Linux */
+    }
+
+    if (json)
+    {
+	fputs("{\"time\":{", fp);
+	for (i = 0; i < ST_PHASES; i++)
+	    fprintf(fp, "\"%s\":{\"wall\":%.6f,\"cpu\":%.6f},",
+		    phase_names[i], sp->wall[i], sp->cpu[i]+sp->est[i]);
+	fprintf(fp, "\"total\":{\"wall\":%.6f,\"cpu\":%.6f}}", wall, cpu);
+
+	fprintf(fp, ",\"bytes\":%llu,\"tags\":{", sp->bytes);
+	for (i = 0; i < ST_MAXTAGS && tag_names[i]; i++)
+	    fprintf(fp, "%s\"%s\":%llu", i ? "," : "", tag_names[i], sp->tags[i]);
+
+	fprintf(fp, "},\"cells\":%llu,\"span_cells\":%llu,\"entities\":%llu",
+		sp->cells, sp->span_cells, sp->entities);
+	fprintf(fp, ",\"recovered\":{\"td_closed\":%llu,\"tr_closed\":%llu,\"tr_opened\":%llu}",
+		sp->td_closed, sp->tr_closed, sp->tr_opened);
+	fprintf(fp, ",\"allocs\":%llu,\"alloc_bytes\":%llu,\"peak_rss_kb\":%ld",
+		sp->allocs, sp->alloc_bytes, rss);
+    }
+    else
+    {
+	fprintf(fp, "%-16s %12s %12s\n", "Time (s):", "wall", "cpu");
+	for (i = 0; i < ST_PHASES; i++)
+	    fprintf(fp, "  %-14s %12.6f %12.6f\n", phase_names[i], sp->wall[i], sp->cpu[i]+sp->est[i]);
+	fprintf(fp, "  %-14s %12.6f %12.6f\n", "total", wall, cpu);
+
+	fprintf(fp, "Bytes scanned:   %llu (%.1f MB/s)\n", sp->bytes,
+		wall > 0 ? sp->bytes/wall/(1024*1024) : 0.0);
+	fputs("Tags:           ", fp);
+	for (i = 0; i < ST_MAXTAGS && tag_names[i]; i++)
+	    fprintf(fp, " %s=%llu", tag_names[i], sp->tags[i]);
+	putc('\n', fp);
+
+	fprintf(fp, "Cells:           %llu (%llu filled by spans)\n", sp->cells, sp->span_cells);
+	fprintf(fp, "Entities:        %llu\n", sp->entities);
+	fprintf(fp, "Recovered:       %llu TD closed, %llu TR closed, %llu TR opened\n",
+		sp->td_closed, sp->tr_closed, sp->tr_opened);
+	fprintf(fp, "Allocations:     %llu (%llu bytes)\n", sp->allocs, sp->alloc_bytes);
+	fprintf(fp, "Peak RSS:        %ld KB\n", rss);
+    }
+
+#ifdef __NR_perf_event_open
+    for (i = 0; hw[i].name; i++)
+    {
+	if (hw[i].fd < 0 || read(hw[i].fd, &v, sizeof(v)) != sizeof(v))
+	    continue;
+
+	if (json)
+	    fprintf(fp, ",\"%s\":%llu", hw[i].name, v);
+	else
+	    fprintf(fp, "%s:%*s %llu\n", hw[i].name, (int) (15-strlen(hw[i].name)), "", v);
+    }
+#else
+    (void) v;
+#endif
+
+    if (json)
+	fputs("}\n", fp);
+}
@@ -0,0 +1,68 @@
+/* stats.h */
+
+#ifndef PHTX_STATS_H
+#define PHTX_STATS_H
+
+/* Phases the run time is split into */
+#define ST_LOAD    0  /* Opening, mapping and reading the input */
+#define ST_PARSE   1  /* Scanning and building tables */
+#define ST_DECODE  2  /* Entity and charset decoding of cell text */
+#define ST_EMIT    3  /* Printing tables and merging -j output */
+#define ST_PHASES  4
+
+#define ST_MAXTAGS 16 /* Tag classes counted */
+
+typedef struct stats {
+    double wall[ST_PHASES];
+    double cpu[ST_PHASES];
+    double est[ST_PHASES];          /* Wall time still without CPU time */
+
+    unsigned long long bytes;       /* Input bytes scanned */
+    unsigned long long tags[ST_MAXTAGS];
+    unsigned long long cells;       /* Cells stored */
+    unsigned long long span_cells;  /* ... and filled by a row/colspan */
+    unsigned long long entities;    /* Character references decoded */
+    unsigned long long td_closed;   /* Recoveries from missing tags */
+    unsigned long long tr_closed;
+    unsigned long long tr_opened;
+    unsigned long long allocs;      /* Table memory allocations */
+    unsigned long long alloc_bytes;
+} STATS;
+
+/* Start of a timed section, see st_start() */
+typedef struct st_clock {
+    double wall;
+    double cpu;       /* Thread CPU time, or < 0 if not measured */
+    double in_wall;   /* Time of all phases at the start */
+    double in_cpu;
+} ST_CLOCK;
+
+
+extern double
+st_wall(void);
+
+extern void
+st_start(STATS *sp,
+	 ST_CLOCK *cp,
+	 int cpu);
+
+extern void
+st_stop(STATS *sp,
+	ST_CLOCK *cp,
+	int phase);
+
+extern void
+st_add(STATS *dst,
+       const STATS *src);
+
+extern void
+st_hw_start(void);
+
+extern void
+st_print(FILE *fp,
+	 const STATS *sp,
+	 const char **tag_names,
+	 double wall,
+	 int json);
+
+#endif